@@ -0,0 +1,158 @@
+/*
+ * =============================================================================
+ * On-target benchmark (CONFIG_APP_BENCHMARK)
+ * =============================================================================
+ * Built instead of main.c. Renders each demo screen for a fixed number of
+ * frames and prints one result line per screen, for tracking regressions
+ * across Zephyr/LVGL upgrades on real hardware:
+ *
+ *   BENCH,screen=Text,frames=100,fps=...,render_us=...,transpose_us=...,
+ *         flush_us=...,flush_max_us=...,bytes_per_frame=...,
+ *         unchanged_per_frame=...,heap_used=...,heap_peak=...
+ *
+ * (one line, no spaces, key=value fields). "BENCH DONE" follows the last
+ * screen. Every frame redraws the whole screen (the screen is invalidated
+ * before each lv_refr_now()), so the numbers are the worst case for that
+ * screen's widgets and do not depend on what happened to change. Frames are
+ * pipelined exactly like in the demo: LVGL renders frame N+1 while the flush
+ * thread sends frame N.
+ *
+ * bench.conf turns the display RAM shadow off, so bytes_per_frame is the
+ * full dirty window. With it on (the benchmark.shadow twister scenario) the
+ * redraws change no pixels: bytes_per_frame shows what is still sent and
+ * unchanged_per_frame the bytes the shadow dropped.
+ *
+ * Build with:  west build -b bruno_nrf52832_nrf52832 -- -DEXTRA_CONF_FILE=bench.conf
+ *
+ * On native_sim the capture display (capture_display.c) stands in for the
+ * panel. After each screen its frame is printed as CAPTURE lines, for
+ * scripts/capture_frames.py to compare with golden images, and the
+ * process exits when done. Times on native_sim are simulated time, not
+ * host CPU time: profile zephyr.exe with perf or valgrind for real cost.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/printk.h>
+#include <lvgl.h>
+#include <lvgl_mem.h>
+
+#ifdef CONFIG_ARCH_POSIX
+#include <posix_board_if.h>
+#endif
+
+#include "capture_display.h"
+#include "demos.h"
+#include "panel.h"
+#include "perf.h"
+#include "screen_cache.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+/* Render one screen CONFIG_APP_BENCH_FRAMES times and print its results */
+static void bench_screen(struct screen *s)
+{
+	struct sys_memory_stats before, after;
+	struct panel_stats bus_before, bus_after;
+	struct perf_summary sum;
+
+	/* Build it here (not in screen_cache_show) to see what it allocates */
+	lvgl_heap_stats(&before);
+	screen_cache_build_all(s, 1);
+	lvgl_heap_stats(&after);
+
+	/* Load it and send one untimed frame, so the first measured frame
+	 * does not include the screen switch */
+	screen_cache_show(s);
+	lv_refr_now(NULL);
+	panel_flush_wait();
+	perf_reset();
+	panel_get_stats(&bus_before);
+
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < CONFIG_APP_BENCH_FRAMES; i++) {
+		lv_obj_invalidate(s->obj);
+		perf_render_begin();
+		lv_refr_now(NULL);
+		perf_render_end();
+	}
+	panel_flush_wait();
+	panel_get_stats(&bus_after);
+
+	uint32_t elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	if (perf_get_summary(s->name, &sum) != 0) {
+		printk("BENCH,screen=%s,error=no_samples\n", s->name);
+		return;
+	}
+
+	/* Rendered frames, not flushes: strip mode and the marquee overlays
+	 * send one frame in several flushes */
+	const uint32_t frames = sum.metric[PERF_RENDER].count;
+	/* Frames per second x10, to print one decimal without floats */
+	const uint32_t fps_x10 = elapsed_us ?
+		(uint32_t)((uint64_t)CONFIG_APP_BENCH_FRAMES * 10U * USEC_PER_SEC /
+			   elapsed_us) : 0U;
+
+	printk("BENCH,screen=%s,frames=%u,fps=%u.%u,render_us=%u,transpose_us=%u,"
+	       "flush_us=%u,flush_max_us=%u,frame_us=%u,frame_sd_us=%u,"
+	       "frame_max_us=%u,bytes_per_frame=%u,unchanged_per_frame=%u,"
+	       "heap_used=%zu,heap_peak=%zu\n",
+	       s->name, frames, fps_x10 / 10U, fps_x10 % 10U,
+	       sum.metric[PERF_RENDER].avg_us, sum.metric[PERF_TRANSPOSE].avg_us,
+	       sum.metric[PERF_FLUSH].avg_us, sum.metric[PERF_FLUSH].max_us,
+	       sum.metric[PERF_FRAME].avg_us, sum.metric[PERF_FRAME].sd_us,
+	       sum.metric[PERF_FRAME].max_us,
+	       frames ? (uint32_t)(sum.bytes / frames) : 0U,
+	       frames ? (bus_after.unchanged - bus_before.unchanged) / frames : 0U,
+	       after.allocated_bytes - before.allocated_bytes,
+	       after.max_allocated_bytes);
+}
+
+int main(void)
+{
+	const struct device *display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+	if (!device_is_ready(display_dev)) {
+		LOG_ERR("Display device not ready");
+		return 0;
+	}
+
+	perf_init();
+
+	if (panel_init(display_dev) != 0) {
+		LOG_ERR("Panel flush setup failed");
+		return 0;
+	}
+
+	lv_refr_now(NULL);
+	display_blanking_off(display_dev);
+	panel_flush_wait();
+
+	printk("BENCH START,frames=%d,screens=%zu,styles=%s,shadow=%s\n",
+	       CONFIG_APP_BENCH_FRAMES, demo_screen_count,
+	       IS_ENABLED(CONFIG_APP_SHARED_STYLES) ? "shared" : "local",
+	       IS_ENABLED(CONFIG_APP_PANEL_SHADOW) ? "on" : "off");
+
+	for (size_t i = 0; i < demo_screen_count; i++) {
+		bench_screen(&demo_screens[i]);
+		/* Host build only: print the last frame for golden comparison */
+		capture_display_dump(display_dev, demo_screens[i].name);
+	}
+
+	printk("BENCH DONE\n");
+
+#ifdef CONFIG_ARCH_POSIX
+	/* Host build: end the process, so CI and profilers see the exit */
+	posix_exit(0);
+#endif
+	return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * =============================================================================
+ * Frame-capture display for host builds
+ * =============================================================================
+ * The buffer layout is the SH1106's: one byte per column per 8-row page, bit
+ * 0 at the top. Pixels are stored as 1 = lit whatever format the app picks.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#define DT_DRV_COMPAT app_capture_display
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <string.h>
+
+#include "capture_display.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(capture_display, LOG_LEVEL_INF);
+
+struct capture_config {
+	uint16_t width;
+	uint16_t height;
+};
+
+struct capture_data {
+	uint8_t *ram;                       /* height / 8 pages of width bytes */
+	enum display_pixel_format format;
+	uint32_t writes;
+	uint32_t bytes;
+};
+
+static int capture_write(const struct device *dev, const uint16_t x,
+			 const uint16_t y,
+			 const struct display_buffer_descriptor *desc,
+			 const void *buf)
+{
+	const struct capture_config *config = dev->config;
+	struct capture_data *data = dev->data;
+	const uint8_t *src = buf;
+	const uint8_t invert = (data->format == PIXEL_FORMAT_MONO10) ? 0xFF : 0x00;
+
+	if ((y % 8U) != 0U || (desc->height % 8U) != 0U ||
+	    x + desc->width > config->width || y + desc->height > config->height) {
+		LOG_ERR("Bad window %ux%u at %u,%u", desc->width, desc->height, x, y);
+		return -EINVAL;
+	}
+
+	for (uint16_t p = 0; p < desc->height / 8U; p++) {
+		uint8_t *dst = &data->ram[(y / 8U + p) * config->width + x];
+
+		for (uint16_t i = 0; i < desc->width; i++) {
+			dst[i] = src[p * desc->pitch + i] ^ invert;
+		}
+	}
+
+	data->writes++;
+	data->bytes += desc->width * desc->height / 8U;
+	return 0;
+}
+
+static int capture_blanking(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+	return 0;
+}
+
+static int capture_set_contrast(const struct device *dev, const uint8_t contrast)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(contrast);
+	return 0;
+}
+
+static void capture_get_capabilities(const struct device *dev,
+				     struct display_capabilities *caps)
+{
+	const struct capture_config *config = dev->config;
+	struct capture_data *data = dev->data;
+
+	memset(caps, 0, sizeof(*caps));
+	caps->x_resolution = config->width;
+	caps->y_resolution = config->height;
+	caps->supported_pixel_formats = PIXEL_FORMAT_MONO01 | PIXEL_FORMAT_MONO10;
+	caps->current_pixel_format = data->format;
+	caps->screen_info = SCREEN_INFO_MONO_VTILED;
+}
+
+static int capture_set_pixel_format(const struct device *dev,
+				    const enum display_pixel_format format)
+{
+	struct capture_data *data = dev->data;
+
+	if (format != PIXEL_FORMAT_MONO01 && format != PIXEL_FORMAT_MONO10) {
+		return -ENOTSUP;
+	}
+
+	data->format = format;
+	return 0;
+}
+
+static DEVICE_API(display, capture_api) = {
+	.blanking_on = capture_blanking,
+	.blanking_off = capture_blanking,
+	.write = capture_write,
+	.set_contrast = capture_set_contrast,
+	.get_capabilities = capture_get_capabilities,
+	.set_pixel_format = capture_set_pixel_format,
+};
+
+void capture_display_dump(const struct device *dev, const char *tag)
+{
+	const struct capture_config *config = dev->config;
+	struct capture_data *data = dev->data;
+
+	printk("CAPTURE,screen=%s,writes=%u,bytes=%u\n", tag, data->writes,
+	       data->bytes);
+
+	for (uint16_t p = 0; p < config->height / 8U; p++) {
+		const uint8_t *row = &data->ram[p * config->width];
+
+		printk("CAPTURE,screen=%s,page=%u,", tag, p);
+		for (uint16_t x = 0; x < config->width; x++) {
+			printk("%02x", row[x]);
+		}
+		printk("\n");
+	}
+
+	data->writes = 0;
+	data->bytes = 0;
+}
+
+#define CAPTURE_DEFINE(n)                                                     \
+	static uint8_t capture_ram_##n[DT_INST_PROP(n, width) *               \
+				       DT_INST_PROP(n, height) / 8];          \
+	static const struct capture_config capture_config_##n = {            \
+		.width = DT_INST_PROP(n, width),                              \
+		.height = DT_INST_PROP(n, height),                            \
+	};                                                                    \
+	static struct capture_data capture_data_##n = {                      \
+		.ram = capture_ram_##n,                                       \
+		.format = PIXEL_FORMAT_MONO01,                                \
+	};                                                                    \
+	DEVICE_DT_INST_DEFINE(n, NULL, NULL, &capture_data_##n,               \
+			      &capture_config_##n, POST_KERNEL,               \
+			      CONFIG_DISPLAY_INIT_PRIORITY, &capture_api);
+
+DT_INST_FOREACH_STATUS_OKAY(CAPTURE_DEFINE)
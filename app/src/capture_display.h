@@ -0,0 +1,45 @@
+/*
+ * =============================================================================
+ * Frame-capture display for host builds
+ * =============================================================================
+ * On native_sim there is no SH1106. The "app,capture-display" driver takes
+ * its place (boards/native_sim.overlay): it reports the same page-organized
+ * monochrome format, so the app runs its normal flush path, and it keeps
+ * what was written in a copy of the controller RAM.
+ *
+ * capture_display_dump() prints that copy to the console, so a host script
+ * (scripts/capture_frames.py) can turn it into PBM images and compare them
+ * with golden frames:
+ *
+ *   CAPTURE,screen=<tag>,writes=<n>,bytes=<n>
+ *   CAPTURE,screen=<tag>,page=<p>,<width bytes in hex, LSB = top row>
+ *
+ * 'writes' and 'bytes' count display_write() calls and pixel bytes since the
+ * previous dump.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_CAPTURE_DISPLAY_H_
+#define APP_CAPTURE_DISPLAY_H_
+
+#include <zephyr/device.h>
+
+#ifdef CONFIG_APP_CAPTURE_DISPLAY
+
+/* Print the captured frame of 'dev', labelled 'tag', and reset the counters */
+void capture_display_dump(const struct device *dev, const char *tag);
+
+#else
+
+static inline void capture_display_dump(const struct device *dev,
+					const char *tag)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(tag);
+}
+
+#endif /* CONFIG_APP_CAPTURE_DISPLAY */
+
+#endif /* APP_CAPTURE_DISPLAY_H_ */
@@ -0,0 +1,584 @@
+/*
+ * =============================================================================
+ * Demo screens
+ * =============================================================================
+ * The six demo screens shown by main.c (and measured by bench.c):
+ *   1. Text      - Display text with different fonts (Montserrat 14, UNSCII 8)
+ *   2. Lines     - Draw lines connecting points (triangle + X shape)
+ *   3. Arc       - Draw curved arc shapes (circular progress indicators)
+ *   4. Image     - Display a 1-bit bitmap image (32x32 smiley face)
+ *   5. Canvas    - Draw individual pixels to create custom shapes
+ *   6. MP3       - Simulates an old-school MP3 player with scrolling song
+ *                  title, progress bar, and time counter (like a Foston)
+ *
+ * Each demo "build" function creates its widgets on the screen it is given.
+ * The screen cache (src/screen_cache.c) calls it once per screen, from the
+ * thread that owns LVGL.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>        /* Zephyr kernel (threads, sleep, timing) */
+#include <lvgl.h>                 /* LVGL graphics library (widgets, drawing, fonts) */
+#include <stdio.h>                /* C standard I/O (snprintf for formatting strings) */
+#include <stdbool.h>              /* C standard bool type (true/false) */
+
+#include "demos.h"
+#include "glyph_cache.h"          /* Unpacks each font glyph once instead of every frame */
+#include "input.h"                /* Button presses (the MP3 demo stops early on one) */
+#include "marquee.h"              /* Scrolls the song title without LVGL redraws */
+#include "mono_arc.h"             /* 1-bit arc gauges without anti-aliasing */
+#include "raster.h"               /* Direct span/line/rectangle drawing into canvas buffers */
+#include "styles.h"               /* Const styles shared by all the demo widgets */
+#include "timeline.h"             /* Animation time from the system clock */
+#include "ui.h"                   /* Posts widget updates to the UI thread */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(demos, LOG_LEVEL_INF);
+
+/* --- Constants --------------------------------------------------------------*/
+#define SCREEN_WIDTH     128     /* Display width in pixels */
+#define SCREEN_HEIGHT    64      /* Display height in pixels */
+
+/* --- Fonts -------------------------------------------------------------------
+ * Every label uses one of two fonts, through the glyph cache
+ * (src/glyph_cache.c). Without CONFIG_APP_GLYPH_CACHE they are the plain
+ * LVGL fonts. Labels get them from a shared style (src/styles.c):
+ *   STYLE_TITLE - Montserrat 14px, proportional
+ *   STYLE_SMALL - UNSCII 8px, monospace
+ * FONT_SMALL is for the code that draws text itself (the marquee). */
+#define FONT_SMALL  glyph_cache_font(&lv_font_unscii_8)       /* Monospace, 8px */
+
+
+/* =============================================================================
+ * DEMO 1: TEXT
+ * =============================================================================
+ * Shows how to create text labels with different fonts and positions.
+ * LVGL uses "objects" (widgets) - a label is one type of widget.
+ */
+static void demo_text(lv_obj_t *scr)
+{
+	/* 'scr' is the screen this demo is built on.
+	 * All widgets must be placed on a screen to be visible. */
+
+	/* --- Title label (large font) --- */
+	/* Create a new label widget and attach it to the screen */
+	lv_obj_t *title = lv_label_create(scr);
+	/* Set the text content of the label */
+	lv_label_set_text(title, "SH1106 Demo");
+	/* Change the font to Montserrat 14px (a proportional, smooth font).
+	 * The style is shared with every other title: no per-label copy */
+	styles_apply(title, STYLE_TITLE);
+	/* Position the label: centered horizontally, at the top, 2px down */
+	lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 2);
+
+	/* --- Subtitle label (small font) --- */
+	lv_obj_t *sub = lv_label_create(scr);
+	lv_label_set_text(sub, "128x64 OLED");
+	/* UNSCII 8px is a tiny monospace font (each character has equal width) */
+	styles_apply(sub, STYLE_SMALL);
+	/* Position: centered both horizontally and vertically, shifted 4px down */
+	lv_obj_align(sub, LV_ALIGN_CENTER, 0, 4);
+
+	/* --- Footer label (small font) --- */
+	lv_obj_t *footer = lv_label_create(scr);
+	lv_label_set_text(footer, "Zephyr + LVGL");
+	styles_apply(footer, STYLE_SMALL);
+	/* Position: centered at the bottom, 2px up from edge */
+	lv_obj_align(footer, LV_ALIGN_BOTTOM_MID, 0, -2);
+}
+
+
+/* =============================================================================
+ * DEMO 2: LINES
+ * =============================================================================
+ * Draws lines by connecting a series of (x, y) coordinate points.
+ * We define the points as arrays, then tell LVGL to draw lines through them.
+ */
+
+/* Triangle points: top-center, bottom-left, bottom-right, back to top.
+ * Each {x, y} pair is a point on the screen. The line widget connects them
+ * in order. Repeating the first point closes the triangle. */
+static lv_point_precise_t line_points_triangle[] = {
+	{64, 5}, {20, 58}, {108, 58}, {64, 5}
+};
+
+/* Diagonal line from top-left corner to bottom-right corner */
+static lv_point_precise_t line_points_cross[] = {
+	{0, 0}, {SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1}
+};
+
+/* Diagonal line from top-right corner to bottom-left corner */
+static lv_point_precise_t line_points_cross2[] = {
+	{SCREEN_WIDTH - 1, 0}, {0, SCREEN_HEIGHT - 1}
+};
+
+static void demo_lines(lv_obj_t *scr)
+{
+	/* A "style" defines how lines look: here white and 1 pixel thick.
+	 * Styles are reusable - we apply the same style to all three lines.
+	 * STYLE_LINE is a const style (src/styles.c): it lives in flash and
+	 * never has to be initialized or freed. */
+
+	/* --- Triangle --- */
+	lv_obj_t *tri = lv_line_create(scr);       /* Create a line widget */
+	lv_line_set_points(tri, line_points_triangle, 4); /* Connect 4 points */
+	styles_apply(tri, STYLE_LINE);             /* Apply the white, 1px style */
+
+	/* --- Diagonal line 1 (top-left to bottom-right) --- */
+	lv_obj_t *d1 = lv_line_create(scr);
+	lv_line_set_points(d1, line_points_cross, 2);  /* Connect 2 points */
+	styles_apply(d1, STYLE_LINE);
+
+	/* --- Diagonal line 2 (top-right to bottom-left) --- */
+	lv_obj_t *d2 = lv_line_create(scr);
+	lv_line_set_points(d2, line_points_cross2, 2);
+	styles_apply(d2, STYLE_LINE);
+}
+
+
+/* =============================================================================
+ * DEMO 3: ARC
+ * =============================================================================
+ * An arc is a curved line segment (part of a circle). It's commonly used for
+ * circular progress indicators or gauges. You set the start/end angles and
+ * a value within a range.
+ *
+ * With CONFIG_APP_MONO_ARC (the default) the two gauges are "mono arcs"
+ * (src/mono_arc.c) instead of lv_arc widgets: 1-bit canvases drawn with
+ * integer math, no anti-aliasing. The background shows as a dotted ring and
+ * the value as a solid one.
+ */
+#ifdef CONFIG_APP_MONO_ARC
+static uint8_t arc_buf[MONO_ARC_BUF_SIZE(50)];
+static uint8_t arc2_buf[MONO_ARC_BUF_SIZE(30)];
+static struct mono_arc arc_big;
+static struct mono_arc arc_small;
+#endif
+
+static void demo_arc(lv_obj_t *scr)
+{
+	/* Title label */
+	lv_obj_t *label = lv_label_create(scr);
+	lv_label_set_text(label, "Arc");
+	styles_apply(label, STYLE_SMALL);
+	lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 2);
+
+#ifdef CONFIG_APP_MONO_ARC
+	/* --- Large arc: 50x50, 6 px ring from 0 to 270 degrees, 75% --- */
+	if (mono_arc_init(&arc_big, scr, arc_buf, 50, 6, 0, 270) == 0) {
+		mono_arc_set_value(&arc_big, 75);
+		lv_obj_align(arc_big.canvas, LV_ALIGN_CENTER, -20, 6);
+	}
+
+	/* --- Small arc: 30x30, 4 px full circle, 40% --- */
+	if (mono_arc_init(&arc_small, scr, arc2_buf, 30, 4, 0, 360) == 0) {
+		mono_arc_set_value(&arc_small, 40);
+		lv_obj_align(arc_small.canvas, LV_ALIGN_CENTER, 35, 6);
+	}
+#else
+
+	/* --- Large arc (75% filled, 270 degree sweep) --- */
+	lv_obj_t *arc = lv_arc_create(scr);       /* Create an arc widget */
+	lv_arc_set_range(arc, 0, 100);             /* Value range: 0 to 100 */
+	lv_arc_set_value(arc, 75);                 /* Current value: 75 (so 75% filled) */
+	lv_arc_set_bg_angles(arc, 0, 270);         /* Background arc spans 0 to 270 degrees */
+	lv_obj_set_size(arc, 50, 50);              /* Widget size: 50x50 pixels */
+	lv_obj_align(arc, LV_ALIGN_CENTER, -20, 6); /* Position: left of center */
+	lv_obj_remove_style(arc, NULL, LV_PART_KNOB); /* Hide the knob (drag handle) */
+	styles_apply(arc, STYLE_ARC);              /* Thin track, 4px white indicator */
+
+	/* --- Small arc (40% filled, full 360 degree circle) --- */
+	lv_obj_t *arc2 = lv_arc_create(scr);
+	lv_arc_set_range(arc2, 0, 100);
+	lv_arc_set_value(arc2, 40);                /* 40% filled */
+	lv_arc_set_bg_angles(arc2, 0, 360);        /* Full circle background */
+	lv_obj_set_size(arc2, 30, 30);             /* Smaller: 30x30 pixels */
+	lv_obj_align(arc2, LV_ALIGN_CENTER, 35, 6); /* Position: right of center */
+	lv_obj_remove_style(arc2, NULL, LV_PART_KNOB);
+	styles_apply(arc2, STYLE_ARC);
+#endif
+}
+
+
+/* =============================================================================
+ * DEMO 4: BITMAP IMAGE
+ * =============================================================================
+ * Displays a pre-defined bitmap image. The image is stored as an array of bytes
+ * where each bit represents one pixel (1 = visible, 0 = transparent).
+ * This is a 32x32 pixel smiley face.
+ *
+ * With CONFIG_APP_PAGE_IMAGE (the default) the smiley comes from
+ * app/assets/smiley.png instead: the build converts it into the panel's own
+ * page format ("smiley.h", made by scripts/png2page.py), and the panel copies
+ * those bytes straight into the frame (src/page_image.c). LVGL only places
+ * the object; it never decodes or blends the image.
+ */
+#ifdef CONFIG_APP_PAGE_IMAGE
+#include "page_image.h"
+#include "smiley.h"               /* Generated at build time from assets/smiley.png */
+#else
+
+/* The bitmap data: each row is 32 pixels = 4 bytes (8 pixels per byte).
+ * A '1' bit means that pixel is drawn (white on OLED).
+ * A '0' bit means that pixel is transparent (shows background).
+ * The most significant bit (MSB) is the leftmost pixel in each byte. */
+static const uint8_t smiley_map[] = {
+	0x00, 0x03, 0xC0, 0x00,  /* Row 0:  ......####...... (top of circle) */
+	0x00, 0x1F, 0xF8, 0x00,  /* Row 1:  ...##########... */
+	0x00, 0x7F, 0xFE, 0x00,  /* Row 2:  .##############. */
+	0x00, 0xFF, 0xFF, 0x00,  /* Row 3  */
+	0x01, 0xFF, 0xFF, 0x80,  /* Row 4  */
+	0x03, 0xFF, 0xFF, 0xC0,  /* Row 5  */
+	0x07, 0xFF, 0xFF, 0xE0,  /* Row 6  */
+	0x0F, 0xFF, 0xFF, 0xF0,  /* Row 7  */
+	0x0F, 0xFF, 0xFF, 0xF0,  /* Row 8  */
+	0x1F, 0x9F, 0xF9, 0xF8,  /* Row 9:  eyes start (gaps in the filled circle) */
+	0x1F, 0x0F, 0xF0, 0xF8,  /* Row 10: eyes (larger gaps) */
+	0x3F, 0x0F, 0xF0, 0xFC,  /* Row 11 */
+	0x3F, 0x0F, 0xF0, 0xFC,  /* Row 12 */
+	0x3F, 0x9F, 0xF9, 0xFC,  /* Row 13: eyes end */
+	0x3F, 0xFF, 0xFF, 0xFC,  /* Row 14 */
+	0x3F, 0xFF, 0xFF, 0xFC,  /* Row 15 */
+	0x3F, 0xFF, 0xFF, 0xFC,  /* Row 16 */
+	0x3F, 0xFF, 0xFF, 0xFC,  /* Row 17 */
+	0x3F, 0xFF, 0xFF, 0xFC,  /* Row 18 */
+	0x3E, 0xFF, 0xFF, 0x7C,  /* Row 19: mouth starts (gaps form a smile) */
+	0x1E, 0x7F, 0xFE, 0x78,  /* Row 20 */
+	0x1F, 0x3F, 0xFC, 0xF8,  /* Row 21 */
+	0x0F, 0x9F, 0xF9, 0xF0,  /* Row 22 */
+	0x0F, 0xC0, 0x03, 0xF0,  /* Row 23: mouth (big gap = wide smile) */
+	0x07, 0xF0, 0x0F, 0xE0,  /* Row 24 */
+	0x03, 0xFF, 0xFF, 0xC0,  /* Row 25 */
+	0x01, 0xFF, 0xFF, 0x80,  /* Row 26 */
+	0x00, 0xFF, 0xFF, 0x00,  /* Row 27 */
+	0x00, 0x7F, 0xFE, 0x00,  /* Row 28 */
+	0x00, 0x1F, 0xF8, 0x00,  /* Row 29 */
+	0x00, 0x03, 0xC0, 0x00,  /* Row 30: bottom of circle */
+	0x00, 0x00, 0x00, 0x00,  /* Row 31: empty row */
+};
+
+/* Image descriptor: tells LVGL how to interpret the raw byte array above.
+ * This struct provides metadata about the image format and dimensions. */
+static const lv_image_dsc_t smiley_img = {
+	.header = {
+		.magic = LV_IMAGE_HEADER_MAGIC, /* Magic number so LVGL knows this is a valid image */
+		.cf = LV_COLOR_FORMAT_A1,       /* Color format: A1 = 1-bit alpha (each bit = 1 pixel) */
+		.w = 32,                        /* Image width: 32 pixels */
+		.h = 32,                        /* Image height: 32 pixels */
+		.stride = 4,                    /* Bytes per row: 32 pixels / 8 bits = 4 bytes */
+	},
+	.data_size = sizeof(smiley_map),    /* Total size of pixel data in bytes */
+	.data = smiley_map,                 /* Pointer to the actual pixel data array */
+};
+#endif /* CONFIG_APP_PAGE_IMAGE */
+
+static void demo_image(lv_obj_t *scr)
+{
+	/* Title */
+	lv_obj_t *label = lv_label_create(scr);
+	lv_label_set_text(label, "Bitmap");
+	styles_apply(label, STYLE_SMALL);
+	lv_obj_align(label, LV_ALIGN_TOP_MID, 0, 2);
+
+#ifdef CONFIG_APP_PAGE_IMAGE
+	/* A page image object: placed by LVGL, drawn by the panel module */
+	lv_obj_t *img = page_image_create(scr, &smiley_page);
+
+	if (img == NULL) {
+		return;                            /* All image slots taken */
+	}
+#else
+	/* Create an image widget and set our smiley bitmap as its source */
+	lv_obj_t *img = lv_image_create(scr);     /* Create image widget */
+	lv_image_set_src(img, &smiley_img);        /* Point it to our bitmap data */
+#endif
+	lv_obj_align(img, LV_ALIGN_CENTER, 0, 6);  /* Center it on screen */
+}
+
+
+/* =============================================================================
+ * DEMO 5: CANVAS (Pixel-by-pixel drawing)
+ * =============================================================================
+ * A canvas is a special widget where you can set individual pixels.
+ * Unlike other widgets (which are pre-made shapes), the canvas gives you
+ * full control to draw anything pixel by pixel.
+ *
+ * We use A1 format (1 bit per pixel, like the OLED itself): 8 pixels share
+ * one byte, so the raster module (src/raster.c) fills whole bytes at a
+ * time and the buffer is 8x smaller than an 8-bit (L8) canvas.
+ * The buffer size is: (width / 8) * height = 10 * 48 = 480 bytes
+ * (a full 128x64 screen would still only need 1 KiB).
+ */
+#define CANVAS_W 80   /* Canvas width (smaller than screen to save RAM) */
+#define CANVAS_H 48   /* Canvas height */
+
+/* Static buffer in RAM to hold the canvas pixel data.
+ * LV_CANVAS_BUF_SIZE() calculates the exact size needed including alignment.
+ * Parameters: width, height, bits_per_pixel, stride_alignment */
+static uint8_t canvas_buf[LV_CANVAS_BUF_SIZE(CANVAS_W, CANVAS_H, 1, 1)];
+
+static void demo_canvas(lv_obj_t *scr)
+{
+	/* Create canvas widget and assign our RAM buffer to it */
+	lv_obj_t *canvas = lv_canvas_create(scr);
+	lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_H,
+			     LV_COLOR_FORMAT_A1);  /* A1 = 1 bit per pixel (on/off) */
+	lv_obj_align(canvas, LV_ALIGN_CENTER, 0, 0);
+	/* An A1 image only says which pixels are "on"; this gives their color */
+	styles_apply(canvas, STYLE_MONO_IMAGE);
+
+	/* Describe the canvas buffer for the raster module, which writes
+	 * straight into it (no per-pixel lv_canvas_set_px() calls) */
+	struct raster r;
+
+	if (raster_from_canvas(&r, canvas) != 0) {
+		LOG_ERR("Unsupported canvas format");
+		return;
+	}
+
+	/* Fill entire canvas with black (all pixels off) */
+	raster_fill(&r, false);
+
+	/* Draw outer border (rectangle around the canvas edges) */
+	raster_rect(&r, 0, 0, CANVAS_W - 1, CANVAS_H - 1, true);
+
+	/* Draw a smaller inner rectangle (8 pixels from each edge) */
+	raster_rect(&r, 8, 8, CANVAS_W - 9, CANVAS_H - 9, true);
+
+	/* Draw an "X" shape inside the inner rectangle.
+	 * Each diagonal is one Bresenham line: going down inner_h - 1 rows,
+	 * 'x' moves proportionally across the inner width. */
+	int32_t inner_w = CANVAS_W - 18;  /* Width of inner area */
+	int32_t inner_h = CANVAS_H - 18;  /* Height of inner area */
+	int32_t run = ((inner_h - 1) * inner_w) / inner_h;
+
+	raster_line(&r, 9, 9, 9 + run, 9 + inner_h - 1, true);                 /* Left-to-right */
+	raster_line(&r, CANVAS_W - 10, 9, CANVAS_W - 10 - run, 9 + inner_h - 1, true); /* Right-to-left */
+
+	/* Draw a dot pattern in each corner of the canvas (decorative) */
+	for (int32_t dy = 2; dy <= 6; dy += 2) {
+		for (int32_t dx = 2; dx <= 6; dx += 2) {
+			raster_pixel(&r, dx, dy, true);                         /* Top-left */
+			raster_pixel(&r, CANVAS_W - 1 - dx, dy, true);          /* Top-right */
+			raster_pixel(&r, dx, CANVAS_H - 1 - dy, true);          /* Bottom-left */
+			raster_pixel(&r, CANVAS_W - 1 - dx, CANVAS_H - 1 - dy, true); /* Bottom-right */
+		}
+	}
+
+	/* We wrote into the buffer behind LVGL's back: ask it to redraw */
+	lv_obj_invalidate(canvas);
+}
+
+
+/* =============================================================================
+ * DEMO 6: MP3 PLAYER (scrolling text + progress bar)
+ * =============================================================================
+ * Simulates an old-school MP3 player (like a Foston):
+ * - Song title scrolls horizontally across the screen
+ * - A progress bar fills up over time (like a playback timer)
+ * - Current time / total time is displayed
+ *
+ * This demo is self-contained: it runs its own animation loop for 6 seconds
+ * of real time, however long each frame takes.
+ * The loop runs in the application thread and never touches the widgets
+ * itself: it posts the new bar value and time text to the UI thread (ui.h),
+ * which applies them right before the next frame is rendered.
+ */
+#define MP3_DEMO_DURATION_MS 6000  /* Total playback simulation: 6 seconds */
+#define MP3_SONG_TOTAL_SEC   210   /* Fake song length: 3:30 = 210 seconds */
+#define MP3_UPDATE_MS        30    /* How often the bar and time label are updated */
+
+/* UI value slots used by this demo (see ui.h) */
+enum {
+	MP3_VALUE_PROGRESS = 0,    /* Progress bar, 0-100 % */
+	MP3_VALUE_SONG_SEC,        /* Song position in seconds, shown as "m:ss / 3:30" */
+};
+
+#define MP3_SONG_TITLE "Linkin Park - In The End (Hybrid Theory 2000)"
+#define MP3_SONG_X       2       /* Song title position (y must be a page: 16 = page 2) */
+#define MP3_SONG_Y       16
+
+/* The scrolling title, kept from build time for enter/leave */
+static lv_obj_t *mp3_song;
+
+#ifdef CONFIG_APP_MARQUEE
+/* Pre-rendered title strip, scrolled without LVGL redraws (marquee.c) */
+static struct marquee mp3_marquee;
+static bool mp3_use_marquee;
+#endif
+
+/* ui_value_fn for the progress bar */
+static void mp3_set_progress(lv_obj_t *bar, int32_t value)
+{
+	lv_bar_set_value(bar, value, LV_ANIM_OFF);
+}
+
+/* ui_format_fn for the time label */
+static void mp3_format_time(char *buf, size_t len, int32_t song_sec)
+{
+	snprintf(buf, len, "%d:%02d / 3:30", song_sec / 60, song_sec % 60);
+}
+
+static void demo_mp3_build(lv_obj_t *scr)
+{
+	/* --- "Now Playing" title at the top --- */
+	lv_obj_t *title = lv_label_create(scr);
+	lv_label_set_text(title, "> Now Playing");
+	styles_apply(title, STYLE_SMALL);
+	lv_obj_align(title, LV_ALIGN_TOP_LEFT, 2, 2);
+
+	/* --- Song name (scrolling text) ---
+	 * The label is given a fixed width smaller than the text.
+	 * LV_LABEL_LONG_MODE_SCROLL makes it scroll back and forth automatically.
+	 * LVGL handles the animation as long as lv_task_handler() is called. */
+	lv_obj_t *song = lv_label_create(scr);
+	mp3_song = song;
+	lv_label_set_text(song, MP3_SONG_TITLE);
+	/* Small font, scrolling at 20 pixels/sec (STYLE_SCROLL). Lower = smoother
+	 * on small screens; LVGL's default 40px/s is too jumpy for 128px. */
+	styles_apply(song, STYLE_SCROLL);
+	lv_obj_set_width(song, SCREEN_WIDTH - 4);  /* Constrain width to force scroll */
+	/* Clipped until the screen is shown: a hidden screen should not keep
+	 * an LVGL animation ticking (see demo_mp3_enter / demo_mp3_leave) */
+	lv_label_set_long_mode(song, LV_LABEL_LONG_MODE_CLIP);
+	lv_obj_align(song, LV_ALIGN_TOP_LEFT, MP3_SONG_X, MP3_SONG_Y);
+
+#ifdef CONFIG_APP_MARQUEE
+	/* Render the title once into a strip; while the screen is shown the
+	 * strip covers the (clipped) label and moves on its own. If the title
+	 * does not fit the strip, the label scrolls itself as before. */
+	mp3_use_marquee = (marquee_init(&mp3_marquee, scr, MP3_SONG_TITLE, FONT_SMALL,
+					MP3_SONG_X, MP3_SONG_Y, SCREEN_WIDTH - 4) == 0);
+#endif
+
+	/* --- Progress bar ---
+	 * A bar widget that we fill from 0% to 100% during the demo. */
+	lv_obj_t *bar = lv_bar_create(scr);
+	styles_apply(bar, STYLE_BAR);                  /* Outline + solid white fill */
+	lv_obj_set_size(bar, SCREEN_WIDTH - 10, 8);   /* Almost full width, 8px tall */
+	lv_obj_align(bar, LV_ALIGN_BOTTOM_MID, 0, -16);
+	lv_bar_set_range(bar, 0, 100);                 /* Range: 0 to 100% */
+	lv_bar_set_value(bar, 0, LV_ANIM_OFF);         /* Start at 0% */
+	ui_bind_value(MP3_VALUE_PROGRESS, bar, mp3_set_progress);
+
+	/* --- Time label (e.g., "0:00 / 3:30") --- */
+	lv_obj_t *time_label = lv_label_create(scr);
+	lv_label_set_text(time_label, "0:00 / 3:30");
+	styles_apply(time_label, STYLE_SMALL);
+	lv_obj_align(time_label, LV_ALIGN_BOTTOM_MID, 0, -4);
+	ui_bind_label(MP3_VALUE_SONG_SEC, time_label, mp3_format_time);
+}
+
+/* The MP3 screen was loaded: start scrolling the song title */
+static void demo_mp3_enter(void)
+{
+#ifdef CONFIG_APP_MARQUEE
+	if (mp3_use_marquee) {
+		marquee_start(&mp3_marquee);
+		return;
+	}
+#endif
+	lv_label_set_long_mode(mp3_song, LV_LABEL_LONG_MODE_SCROLL);
+}
+
+/* Runs every time the MP3 screen is shown: plays the 6-second animation */
+static void demo_mp3_run(void)
+{
+	/* --- Animation loop ---
+	 * We post a new bar value and song position every MP3_UPDATE_MS.
+	 * Over 6 seconds, the bar goes from 0% to 100% and the time counts up
+	 * proportionally to the fake 3:30 song duration. Posting a value that
+	 * did not change (the bar moves 1% every 60 ms) costs almost nothing:
+	 * the UI layer drops it before LVGL sees it.
+	 *
+	 * The time comes from a timeline (src/timeline.c): the real time since
+	 * the demo started, read from the system clock. If a frame is slow,
+	 * the next update simply shows a later position (a dropped frame)
+	 * instead of the whole playback slowing down. */
+	struct timeline tl;
+	int32_t elapsed_ms;
+
+	timeline_start(&tl, MP3_DEMO_DURATION_MS, MP3_UPDATE_MS);
+
+	/* timeline_next() sleeps until the next update is due, and returns
+	 * -1 when the 6 seconds are over. Its last value is exactly 6000 ms,
+	 * so the bar always ends full and the time at 3:30. */
+	while ((elapsed_ms = timeline_next(&tl)) >= 0) {
+		/* Calculate progress percentage (0-100) */
+		ui_set_value(MP3_VALUE_PROGRESS,
+			     timeline_scale(elapsed_ms, MP3_DEMO_DURATION_MS, 100));
+
+		/* Calculate fake song time based on progress.
+		 * If song is 3:30 (210s), map elapsed demo time to song time. */
+		ui_set_value(MP3_VALUE_SONG_SEC,
+			     timeline_scale(elapsed_ms, MP3_DEMO_DURATION_MS,
+					    MP3_SONG_TOTAL_SEC));
+
+		/* The UI thread renders (and scrolls the title) meanwhile */
+
+		/* A button press: stop here, main.c goes to the next demo */
+		if (input_pending()) {
+			break;
+		}
+	}
+
+	if (tl.dropped > 0U) {
+		LOG_DBG("MP3: %u late updates dropped", tl.dropped);
+	}
+}
+
+/* Leaving the MP3 screen: stop the title scroll animation */
+static void demo_mp3_leave(void)
+{
+#ifdef CONFIG_APP_MARQUEE
+	if (mp3_use_marquee) {
+		marquee_stop(&mp3_marquee);
+		return;
+	}
+#endif
+	lv_label_set_long_mode(mp3_song, LV_LABEL_LONG_MODE_CLIP);
+}
+
+
+/* =============================================================================
+ * STATUS SCREEN (second panel)
+ * =============================================================================
+ * With a second display attached (dual_panel.overlay), it shows which demo
+ * is running on the first one. main.c posts the name to a text slot.
+ */
+void demo_status_build(lv_obj_t *scr)
+{
+	lv_obj_t *title = lv_label_create(scr);
+	lv_label_set_text(title, "Now showing");
+	styles_apply(title, STYLE_SMALL);
+	lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 4);
+
+	/* The demo name, updated through the UI thread's text slot */
+	lv_obj_t *name = lv_label_create(scr);
+	styles_apply(name, STYLE_TITLE);
+	lv_obj_align(name, LV_ALIGN_CENTER, 0, 4);
+	ui_bind_text(DEMO_TEXT_STATUS, name);
+}
+
+
+/* =============================================================================
+ * DEMO SCREEN TABLE
+ * =============================================================================
+ * Each demo is a "screen": a name, a function that creates its widgets
+ * once, and optionally a function that animates it while it is shown.
+ */
+struct screen demo_screens[] = {
+	{ .name = "Text",   .build = demo_text },     /* Demo 1 */
+	{ .name = "Lines",  .build = demo_lines },    /* Demo 2 */
+	{ .name = "Arc",    .build = demo_arc },      /* Demo 3 */
+	{ .name = "Image",  .build = demo_image },    /* Demo 4 */
+	{ .name = "Canvas", .build = demo_canvas },   /* Demo 5 */
+	/* Demo 6: MP3 player (has its own 6-second animation loop) */
+	{ .name = "MP3",    .build = demo_mp3_build, .enter = demo_mp3_enter,
+	  .run = demo_mp3_run, .leave = demo_mp3_leave },
+};
+
+/* ARRAY_SIZE() is a macro that calculates how many elements are in an array */
+const size_t demo_screen_count = ARRAY_SIZE(demo_screens);
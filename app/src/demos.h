@@ -0,0 +1,27 @@
+/*
+ * =============================================================================
+ * Demo screens
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_DEMOS_H_
+#define APP_DEMOS_H_
+
+#include <lvgl.h>
+#include <stddef.h>
+
+#include "screen_cache.h"
+
+/* The demo screens, in the order they are shown */
+extern struct screen demo_screens[];
+extern const size_t demo_screen_count;
+
+/* Text slot shown on the second panel's status screen */
+#define DEMO_TEXT_STATUS 0
+
+/* Build the status screen of the second panel (dual_panel.overlay) */
+void demo_status_build(lv_obj_t *scr);
+
+#endif /* APP_DEMOS_H_ */
@@ -0,0 +1,189 @@
+/*
+ * =============================================================================
+ * Pre-rasterized glyph cache for the built-in fonts
+ * =============================================================================
+ * A cached font is a copy of the base lv_font_t with get_glyph_bitmap
+ * replaced. Glyph metrics still come from the base font; only the bitmap
+ * lookup goes through the cache:
+ *
+ *   hit:  point a draw buffer descriptor at the stored A8 bitmap (no copy)
+ *   miss: let the base font unpack the glyph, threshold it into the pool,
+ *         then proceed as for a hit
+ *
+ * LVGL draws each letter as soon as it has fetched its bitmap, so a single
+ * descriptor (glyph_out) can be reused for every glyph.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "glyph_cache.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(glyph_cache, LOG_LEVEL_INF);
+
+#define GLYPH_CACHE_ENTRIES CONFIG_APP_GLYPH_CACHE_ENTRIES
+
+BUILD_ASSERT(IS_POWER_OF_TWO(GLYPH_CACHE_ENTRIES),
+	     "CONFIG_APP_GLYPH_CACHE_ENTRIES must be a power of two");
+BUILD_ASSERT(CONFIG_APP_GLYPH_CACHE_SIZE <= UINT16_MAX);
+
+/* Alpha at or above this counts as "on" (LVGL's own 1-bit threshold) */
+#define GLYPH_ALPHA_THRESHOLD 128
+
+struct glyph_entry {
+	const lv_font_t *font;    /* NULL = empty slot */
+	uint32_t index;           /* Glyph index inside the font */
+	uint16_t offset;          /* Bitmap start in glyph_pool */
+	uint8_t w;
+	uint8_t h;
+};
+
+/* A cached font and the base font it was copied from */
+struct glyph_font {
+	lv_font_t font;
+	const lv_font_t *base;
+};
+
+static struct glyph_font glyph_fonts[CONFIG_APP_GLYPH_CACHE_FONTS];
+static struct glyph_entry glyph_table[GLYPH_CACHE_ENTRIES];
+static uint8_t glyph_pool[CONFIG_APP_GLYPH_CACHE_SIZE];
+static uint16_t glyph_pool_used;
+static uint16_t glyph_count;
+static lv_draw_buf_t glyph_out;
+static struct glyph_cache_stats glyph_stats;
+
+static void glyph_cache_flush(void)
+{
+	memset(glyph_table, 0, sizeof(glyph_table));
+	glyph_pool_used = 0;
+	glyph_count = 0;
+	glyph_stats.flushes++;
+}
+
+static struct glyph_entry *glyph_lookup(const lv_font_t *font, uint32_t index)
+{
+	uint32_t slot = (index * 2654435761U) ^ (uint32_t)(uintptr_t)font;
+
+	/* Linear probing; the table is never allowed to fill up completely */
+	for (uint32_t i = 0; i < GLYPH_CACHE_ENTRIES; i++) {
+		struct glyph_entry *e = &glyph_table[(slot + i) & (GLYPH_CACHE_ENTRIES - 1)];
+
+		if (e->font == NULL || (e->font == font && e->index == index)) {
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+/* Threshold the A8 bitmap the base font produced into the pool */
+static struct glyph_entry *glyph_insert(const lv_font_glyph_dsc_t *g,
+					const lv_draw_buf_t *src)
+{
+	const uint32_t size = g->box_w * g->box_h;
+
+	if (size > sizeof(glyph_pool) || g->box_w > UINT8_MAX ||
+	    g->box_h > UINT8_MAX) {
+		return NULL;
+	}
+
+	/* Out of pool space or table slots: start over. The glyphs that are
+	 * still on screen come back on their next miss. */
+	if (glyph_pool_used + size > sizeof(glyph_pool) ||
+	    glyph_count >= (GLYPH_CACHE_ENTRIES * 3) / 4) {
+		glyph_cache_flush();
+	}
+
+	struct glyph_entry *e = glyph_lookup(g->resolved_font, g->gid.index);
+	uint8_t *dst = &glyph_pool[glyph_pool_used];
+
+	for (uint32_t y = 0; y < g->box_h; y++) {
+		const uint8_t *row = src->data + y * src->header.stride;
+
+		for (uint32_t x = 0; x < g->box_w; x++) {
+			*dst++ = (row[x] >= GLYPH_ALPHA_THRESHOLD) ? 0xFF : 0x00;
+		}
+	}
+
+	e->font = g->resolved_font;
+	e->index = g->gid.index;
+	e->offset = glyph_pool_used;
+	e->w = g->box_w;
+	e->h = g->box_h;
+
+	glyph_pool_used += size;
+	glyph_count++;
+	return e;
+}
+
+static const void *glyph_cache_get_bitmap(lv_font_glyph_dsc_t *g,
+					  lv_draw_buf_t *draw_buf)
+{
+	const struct glyph_font *gf =
+		CONTAINER_OF(g->resolved_font, struct glyph_font, font);
+	const lv_font_t *base = gf->base;
+
+	/* Raw bitmaps (not for drawing), empty glyphs and anything that is
+	 * not an alpha mask go straight to the base font */
+	if (g->req_raw_bitmap || g->box_w == 0U || g->box_h == 0U ||
+	    g->format < LV_FONT_GLYPH_FORMAT_A1 ||
+	    g->format > LV_FONT_GLYPH_FORMAT_A8) {
+		return base->get_glyph_bitmap(g, draw_buf);
+	}
+
+	struct glyph_entry *e = glyph_lookup(g->resolved_font, g->gid.index);
+
+	if (e != NULL && e->font != NULL) {
+		glyph_stats.hits++;
+	} else {
+		const lv_draw_buf_t *src = base->get_glyph_bitmap(g, draw_buf);
+
+		glyph_stats.misses++;
+		if (src == NULL) {
+			return NULL;
+		}
+
+		e = glyph_insert(g, src);
+		if (e == NULL) {
+			/* Too big to cache: draw the base font's copy */
+			return src;
+		}
+	}
+
+	lv_draw_buf_init(&glyph_out, e->w, e->h, LV_COLOR_FORMAT_A8, e->w,
+			 &glyph_pool[e->offset], (uint32_t)e->w * e->h);
+	return &glyph_out;
+}
+
+const lv_font_t *glyph_cache_font(const lv_font_t *base)
+{
+	for (int i = 0; i < ARRAY_SIZE(glyph_fonts); i++) {
+		struct glyph_font *gf = &glyph_fonts[i];
+
+		if (gf->base == base) {
+			return &gf->font;
+		}
+
+		if (gf->base == NULL) {
+			gf->font = *base;
+			gf->font.get_glyph_bitmap = glyph_cache_get_bitmap;
+			gf->base = base;
+			return &gf->font;
+		}
+	}
+
+	LOG_WRN("No glyph cache font slot left");
+	return base;
+}
+
+void glyph_cache_get_stats(struct glyph_cache_stats *stats)
+{
+	*stats = glyph_stats;
+	stats->used_bytes = glyph_pool_used;
+}
@@ -0,0 +1,59 @@
+/*
+ * =============================================================================
+ * Pre-rasterized glyph cache for the built-in fonts
+ * =============================================================================
+ * LVGL's built-in fonts store glyphs packed at 1 or 4 bits per pixel. Every
+ * time a letter is drawn, LVGL unpacks it into an 8-bit alpha (A8) bitmap
+ * and then blends that into the frame. On a screen full of text this
+ * unpacking has to be redone for every letter of every frame.
+ *
+ * glyph_cache_font() returns a copy of a font whose glyph bitmaps are
+ * unpacked once and kept in a fixed RAM pool (CONFIG_APP_GLYPH_CACHE_SIZE
+ * bytes). Alpha is thresholded to fully on or off while caching: that is
+ * all a 1-bit panel can show, and it lets LVGL skip the per-pixel mixing
+ * of partly-covered pixels. When the pool is full it is emptied and refilled
+ * with the glyphs still in use.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_GLYPH_CACHE_H_
+#define APP_GLYPH_CACHE_H_
+
+#include <lvgl.h>
+#include <stdint.h>
+
+struct glyph_cache_stats {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t flushes;         /* Times the pool was full and emptied */
+	uint32_t used_bytes;
+};
+
+#ifdef CONFIG_APP_GLYPH_CACHE
+
+/*
+ * Return the cached version of 'base' (created on first call). Falls back to
+ * 'base' itself when all CONFIG_APP_GLYPH_CACHE_FONTS slots are taken.
+ * Call from the thread that owns LVGL.
+ */
+const lv_font_t *glyph_cache_font(const lv_font_t *base);
+
+void glyph_cache_get_stats(struct glyph_cache_stats *stats);
+
+#else
+
+static inline const lv_font_t *glyph_cache_font(const lv_font_t *base)
+{
+	return base;
+}
+
+static inline void glyph_cache_get_stats(struct glyph_cache_stats *stats)
+{
+	*stats = (struct glyph_cache_stats){ 0 };
+}
+
+#endif /* CONFIG_APP_GLYPH_CACHE */
+
+#endif /* APP_GLYPH_CACHE_H_ */
@@ -0,0 +1,134 @@
+/*
+ * =============================================================================
+ * Low-power idle mode for static screens
+ * =============================================================================
+ * Two states:
+ *
+ *   ACTIVE   LVGL runs normally and we hold a runtime PM reference on the
+ *            SPI bus, so it stays powered.
+ *   IDLE     Entered after CONFIG_APP_IDLE_TIMEOUT_MS without invalidations.
+ *            Pending flushes are drained, the panel is dimmed or blanked,
+ *            and the PM reference is dropped: the SPIM driver suspends and
+ *            moves its pins to the "spi1_sleep" pinctrl state.
+ *
+ * With every thread blocked, the Zephyr idle thread puts the CPU to sleep
+ * (WFE on the nRF52832) until the next wake-up.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+
+#include "idle.h"
+#include "panel.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(idle, LOG_LEVEL_INF);
+
+/* The SPI controller the panel hangs off (spi1 in the .overlay file) */
+#define IDLE_BUS_NODE DT_BUS(DT_CHOSEN(zephyr_display))
+
+static const struct device *const idle_bus = DEVICE_DT_GET(IDLE_BUS_NODE);
+
+static struct {
+	const struct device *display;
+	bool idle;
+	int64_t last_activity_ms;
+} idle_state;
+
+int idle_init(const struct device *display_dev)
+{
+	int err;
+
+	idle_state.display = display_dev;
+	idle_state.last_activity_ms = k_uptime_get();
+
+	if (!pm_device_runtime_is_enabled(idle_bus)) {
+		err = pm_device_runtime_enable(idle_bus);
+		if (err) {
+			LOG_WRN("Runtime PM not available on %s: %d",
+				idle_bus->name, err);
+			return err;
+		}
+	}
+
+	/* Keep the bus powered while the screen is active */
+	err = pm_device_runtime_get(idle_bus);
+	if (err) {
+		LOG_ERR("Failed to resume %s: %d", idle_bus->name, err);
+		return err;
+	}
+
+#ifdef CONFIG_APP_IDLE_DIM
+	display_set_contrast(display_dev, CONFIG_APP_ACTIVE_CONTRAST);
+#endif
+
+	return 0;
+}
+
+void idle_note_activity(void)
+{
+	idle_state.last_activity_ms = k_uptime_get();
+}
+
+static void idle_enter(void)
+{
+	/* Everything already rendered must reach the panel first */
+	panel_flush_wait();
+
+#ifdef CONFIG_APP_IDLE_DIM
+	display_set_contrast(idle_state.display, CONFIG_APP_IDLE_CONTRAST);
+#endif
+#ifdef CONFIG_APP_IDLE_BLANK
+	/* Panel off: the controller keeps its RAM, so nothing has to be
+	 * resent on wake-up */
+	display_blanking_on(idle_state.display);
+#endif
+
+	pm_device_runtime_put(idle_bus);
+	idle_state.idle = true;
+
+	LOG_DBG("Idle");
+}
+
+void idle_exit(void)
+{
+	if (!idle_state.idle) {
+		return;
+	}
+
+	pm_device_runtime_get(idle_bus);
+	idle_state.idle = false;
+
+#ifdef CONFIG_APP_IDLE_BLANK
+	display_blanking_off(idle_state.display);
+#endif
+#ifdef CONFIG_APP_IDLE_DIM
+	/* Back to the contrast the application chose, if it chose one */
+	int contrast = panel_get_contrast();
+
+	display_set_contrast(idle_state.display,
+			     (contrast >= 0) ? contrast : CONFIG_APP_ACTIVE_CONTRAST);
+#endif
+
+	/* A spurious wake-up must not suspend the bus again right away */
+	idle_state.last_activity_ms = k_uptime_get();
+
+	LOG_DBG("Active");
+}
+
+bool idle_update(int64_t now_ms)
+{
+	if (!idle_state.idle &&
+	    (now_ms - idle_state.last_activity_ms) >= CONFIG_APP_IDLE_TIMEOUT_MS) {
+		idle_enter();
+	}
+
+	return idle_state.idle;
+}
@@ -0,0 +1,57 @@
+/*
+ * =============================================================================
+ * Low-power idle mode for static screens
+ * =============================================================================
+ * When nothing on the screen has been invalidated for
+ * CONFIG_APP_IDLE_TIMEOUT_MS, the render scheduler stops running LVGL,
+ * the SPI bus is suspended (switching its pins to the "sleep" pinctrl state)
+ * and the panel is optionally dimmed or blanked. The first change after that
+ * resumes everything, and the accumulated changes go out in one flush.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_IDLE_H_
+#define APP_IDLE_H_
+
+#include <zephyr/device.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef CONFIG_APP_IDLE
+
+/* Take a runtime PM reference on the panel's SPI bus. Call once at boot. */
+int idle_init(const struct device *display_dev);
+
+/* Record that the screen content changed (resets the idle countdown) */
+void idle_note_activity(void);
+
+/* Enter idle if the screen has been static long enough. Returns true when
+ * the system is idle (LVGL should not be run). */
+bool idle_update(int64_t now_ms);
+
+/* Leave idle: resume the SPI bus and restore the panel. No-op if active. */
+void idle_exit(void);
+
+#else
+
+static inline int idle_init(const struct device *display_dev)
+{
+	ARG_UNUSED(display_dev);
+	return 0;
+}
+
+static inline void idle_note_activity(void) {}
+
+static inline bool idle_update(int64_t now_ms)
+{
+	ARG_UNUSED(now_ms);
+	return false;
+}
+
+static inline void idle_exit(void) {}
+
+#endif /* CONFIG_APP_IDLE */
+
+#endif /* APP_IDLE_H_ */
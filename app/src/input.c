@@ -0,0 +1,100 @@
+/*
+ * =============================================================================
+ * Button input (sw0)
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "input.h"
+#include "perf.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(input, LOG_LEVEL_INF);
+
+static const struct gpio_dt_spec input_button = GPIO_DT_SPEC_GET(DT_ALIAS(sw0), gpios);
+static struct gpio_callback input_callback;
+
+/* Given once per press; a binary semaphore, so presses do not queue up */
+static K_SEM_DEFINE(input_sem, 0, 1);
+
+/* Uptime of the last edge, either direction (interrupt context only) */
+static uint32_t input_last_edge_ms;
+
+/*
+ * Called on both edges. A press is an edge to active after the pin has
+ * been quiet (inactive) for the debounce time, so the bounce of the press
+ * and of the release, however long the button was held, never counts. The
+ * press is taken on its first edge: debouncing adds no latency.
+ */
+static void input_isr(const struct device *port, struct gpio_callback *cb,
+		      uint32_t pins)
+{
+	const uint32_t now = k_uptime_get_32();
+	const uint32_t quiet_ms = now - input_last_edge_ms;
+
+	ARG_UNUSED(port);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(pins);
+
+	input_last_edge_ms = now;
+
+	if (quiet_ms < CONFIG_APP_INPUT_DEBOUNCE_MS ||
+	    gpio_pin_get_dt(&input_button) != 1) {
+		return;
+	}
+
+	/* Stamp first: the latency starts here, not where a thread sees it */
+	perf_input_event();
+	k_sem_give(&input_sem);
+}
+
+int input_init(void)
+{
+	int err;
+
+	if (!gpio_is_ready_dt(&input_button)) {
+		LOG_ERR("Button GPIO not ready");
+		return -ENODEV;
+	}
+
+	err = gpio_pin_configure_dt(&input_button, GPIO_INPUT);
+	if (err) {
+		LOG_ERR("Button pin setup failed: %d", err);
+		return err;
+	}
+
+	gpio_init_callback(&input_callback, input_isr, BIT(input_button.pin));
+	err = gpio_add_callback_dt(&input_button, &input_callback);
+	if (err) {
+		LOG_ERR("Button callback failed: %d", err);
+		return err;
+	}
+
+	/* Both edges: the release bounce must restart the quiet time too */
+	input_last_edge_ms = k_uptime_get_32();
+	err = gpio_pin_interrupt_configure_dt(&input_button, GPIO_INT_EDGE_BOTH);
+	if (err) {
+		LOG_ERR("Button interrupt failed: %d", err);
+		return err;
+	}
+
+	LOG_INF("Button on %s pin %u", input_button.port->name, input_button.pin);
+	return 0;
+}
+
+bool input_wait(k_timeout_t timeout)
+{
+	return k_sem_take(&input_sem, timeout) == 0;
+}
+
+bool input_pending(void)
+{
+	return k_sem_count_get(&input_sem) != 0U;
+}
@@ -0,0 +1,58 @@
+/*
+ * =============================================================================
+ * Button input (sw0)
+ * =============================================================================
+ * The button on the devicetree "sw0" alias is read by a GPIO interrupt, not
+ * polled. Each (debounced) press is stamped for the perf "input" metric
+ * in the interrupt handler and wakes whoever waits in input_wait() right away:
+ * main.c then switches to the next demo, and the UI thread renders it without
+ * waiting for the frame rate cap. The metric is the time from that stamp to
+ * the last SPI byte of the frames the press caused.
+ *
+ * Without CONFIG_APP_INPUT (no sw0 on the board) input_wait() just sleeps.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_INPUT_H_
+#define APP_INPUT_H_
+
+#include <zephyr/kernel.h>
+#include <stdbool.h>
+
+#ifdef CONFIG_APP_INPUT
+
+/* Configure the sw0 pin and its interrupt. Call once at boot. */
+int input_init(void);
+
+/*
+ * Wait for a button press, at most 'timeout'. Returns true (and consumes
+ * the press) if there was one, false on timeout.
+ */
+bool input_wait(k_timeout_t timeout);
+
+/* True if a press is waiting for input_wait(); does not consume it */
+bool input_pending(void);
+
+#else
+
+static inline int input_init(void)
+{
+	return 0;
+}
+
+static inline bool input_wait(k_timeout_t timeout)
+{
+	k_sleep(timeout);
+	return false;
+}
+
+static inline bool input_pending(void)
+{
+	return false;
+}
+
+#endif /* CONFIG_APP_INPUT */
+
+#endif /* APP_INPUT_H_ */
@@ -0,0 +1,163 @@
+/*
+ * =============================================================================
+ * Scrolling text line without LVGL redraws
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "idle.h"
+#include "marquee.h"
+#include "mono_transpose.h"
+#include "panel.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(marquee, LOG_LEVEL_INF);
+
+BUILD_ASSERT((CONFIG_APP_MARQUEE_MAX_WIDTH % 8) == 0,
+	     "The strip is converted in 8-column blocks");
+
+/* LVGL 9 puts a 2-entry palette (2 x 4 bytes) in front of I1 pixel data */
+#define MARQUEE_I1_PALETTE_SIZE 8
+
+/* Steps to wait at either end before turning around (like LVGL's scroll) */
+#define MARQUEE_END_PAUSE_STEPS (1000 / CONFIG_APP_MARQUEE_STEP_MS)
+
+/* Scratch I1 canvas the text is rendered into once (one page tall) */
+static uint8_t marquee_canvas_buf[MARQUEE_I1_PALETTE_SIZE +
+				  CONFIG_APP_MARQUEE_MAX_WIDTH / 8 * PANEL_PAGE_ROWS];
+
+/* Render the text with LVGL into the I1 canvas, then transpose it */
+static void marquee_render(struct marquee *m, lv_obj_t *parent,
+			   const char *text, const lv_font_t *font)
+{
+	lv_obj_t *canvas = lv_canvas_create(parent);
+	const uint32_t stride = lv_draw_buf_width_to_stride(m->text_w,
+							    LV_COLOR_FORMAT_I1);
+	lv_draw_label_dsc_t dsc;
+	lv_layer_t layer;
+	lv_area_t area = { 0, 0, m->text_w - 1, PANEL_PAGE_ROWS - 1 };
+
+	lv_canvas_set_buffer(canvas, marquee_canvas_buf, m->text_w,
+			     PANEL_PAGE_ROWS, LV_COLOR_FORMAT_I1);
+	lv_canvas_set_palette(canvas, 0, lv_color32_make(0, 0, 0, 255));
+	lv_canvas_set_palette(canvas, 1, lv_color32_make(255, 255, 255, 255));
+	memset(marquee_canvas_buf + MARQUEE_I1_PALETTE_SIZE, 0,
+	       stride * PANEL_PAGE_ROWS);
+
+	lv_canvas_init_layer(canvas, &layer);
+	lv_draw_label_dsc_init(&dsc);
+	dsc.font = font;
+	dsc.color = lv_color_white();
+	dsc.text = text;
+	lv_draw_label(&layer, &dsc, &area);
+	lv_canvas_finish_layer(canvas, &layer);
+
+	/* I1 rows are MSB-first like the frame buffer: same conversion */
+	mono_transpose_page(marquee_canvas_buf + MARQUEE_I1_PALETTE_SIZE, stride,
+			    0, m->text_w - 1, m->strip, 0x00);
+
+	lv_obj_delete(canvas);
+}
+
+int marquee_init(struct marquee *m, lv_obj_t *parent, const char *text,
+		 const lv_font_t *font, int32_t x, int32_t y, int32_t w)
+{
+	const int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+	int32_t text_w = lv_text_get_width(text, strlen(text), font, 0);
+
+	if ((y % PANEL_PAGE_ROWS) != 0 || font->line_height > PANEL_PAGE_ROWS ||
+	    x < 0 || w <= 0 || x + w > hor_res) {
+		return -EINVAL;
+	}
+
+	/* The strip is padded to the window width when the text is shorter */
+	if (text_w > CONFIG_APP_MARQUEE_MAX_WIDTH ||
+	    w > CONFIG_APP_MARQUEE_MAX_WIDTH) {
+		return -E2BIG;
+	}
+
+	memset(m->strip, 0, sizeof(m->strip));
+	m->text_w = MAX(text_w, w);
+	m->page = y / PANEL_PAGE_ROWS;
+	m->x1 = x;
+	m->x2 = x + w - 1;
+	m->timer = NULL;
+
+	marquee_render(m, parent, text, font);
+	return 0;
+}
+
+static void marquee_show(struct marquee *m)
+{
+	panel_overlay_set(m->page, m->x1, m->x2, &m->strip[m->pos]);
+}
+
+/* Advance one step; returns true if the text moved */
+static bool marquee_advance(struct marquee *m)
+{
+	const int16_t travel = m->text_w - (m->x2 - m->x1 + 1);
+
+	if (m->pause > 0U) {
+		m->pause--;
+		return false;
+	}
+
+	m->pos += m->dir;
+	if (m->pos <= 0 || m->pos >= travel) {
+		m->dir = -m->dir;
+		m->pause = MARQUEE_END_PAUSE_STEPS;
+	}
+
+	return true;
+}
+
+static void marquee_step(lv_timer_t *timer)
+{
+	struct marquee *m = lv_timer_get_user_data(timer);
+	const uint32_t steps = lv_tick_elaps(m->tick) / CONFIG_APP_MARQUEE_STEP_MS;
+	bool moved = false;
+
+	/* Nothing is invalidated in LVGL: keep the bus out of idle ourselves */
+	idle_note_activity();
+
+	/* The position follows the clock: if the timer ran late (a slow
+	 * frame), take all the steps that are due and show only the result */
+	for (uint32_t i = 0; i < steps; i++) {
+		moved |= marquee_advance(m);
+	}
+	m->tick += steps * CONFIG_APP_MARQUEE_STEP_MS;
+
+	if (moved) {
+		marquee_show(m);
+	}
+}
+
+void marquee_start(struct marquee *m)
+{
+	m->pos = 0;
+	m->dir = 1;
+	m->pause = MARQUEE_END_PAUSE_STEPS;
+	m->tick = lv_tick_get();
+	marquee_show(m);
+
+	/* Text that fits needs no timer */
+	if (m->text_w > m->x2 - m->x1 + 1) {
+		m->timer = lv_timer_create(marquee_step, CONFIG_APP_MARQUEE_STEP_MS, m);
+	}
+}
+
+void marquee_stop(struct marquee *m)
+{
+	if (m->timer != NULL) {
+		lv_timer_delete(m->timer);
+		m->timer = NULL;
+	}
+
+	panel_overlay_set(m->page, m->x1, m->x2, NULL);
+}
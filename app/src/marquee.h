@@ -0,0 +1,61 @@
+/*
+ * =============================================================================
+ * Scrolling text line without LVGL redraws
+ * =============================================================================
+ * LV_LABEL_LONG_MODE_SCROLL moves a label one pixel at a time, and every
+ * step re-renders the label, converts its page and sends it. A marquee
+ * instead renders the whole text once, at build time, into a strip of
+ * page-format columns as wide as the text. Each step then only hands a
+ * different window of that strip to the panel (panel_overlay_set()):
+ * LVGL does not run and there is nothing to transpose, the step is one
+ * page window on the SPI bus.
+ *
+ * The SH1106 does not have the SSD1306's horizontal scroll commands, and
+ * its RAM is only 4 columns wider than the screen, so the "virtual" strip
+ * lives in MCU RAM instead of panel RAM.
+ *
+ * The text must sit in one 8-row page: y a multiple of 8, a font at most 8
+ * pixels tall (UNSCII 8).
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_MARQUEE_H_
+#define APP_MARQUEE_H_
+
+#include <lvgl.h>
+#include <stdint.h>
+
+struct marquee {
+	uint8_t strip[CONFIG_APP_MARQUEE_MAX_WIDTH];   /* Column x of the text */
+	int16_t text_w;           /* Used width of strip[] */
+	int16_t page;
+	int16_t x1;               /* Screen window [x1, x2] */
+	int16_t x2;
+	int16_t pos;              /* Strip column shown at x1 */
+	int8_t dir;               /* +1 or -1 */
+	uint8_t pause;            /* Steps left to wait at either end */
+	uint32_t tick;            /* lv_tick_get() of the last step taken */
+	lv_timer_t *timer;
+};
+
+/*
+ * Render 'text' once into the marquee strip. The marquee covers
+ * w columns starting at (x, y) on the screen. 'parent' only hosts a
+ * temporary canvas. UI thread only.
+ *
+ * Returns 0, -EINVAL if the window is not page aligned or the font is too
+ * tall, or -E2BIG if the text or the window is wider than
+ * CONFIG_APP_MARQUEE_MAX_WIDTH.
+ */
+int marquee_init(struct marquee *m, lv_obj_t *parent, const char *text,
+		 const lv_font_t *font, int32_t x, int32_t y, int32_t w);
+
+/* Show the marquee and start moving it (from the beginning of the text) */
+void marquee_start(struct marquee *m);
+
+/* Stop moving it and give the window back to LVGL */
+void marquee_stop(struct marquee *m);
+
+#endif /* APP_MARQUEE_H_ */
@@ -0,0 +1,160 @@
+/*
+ * =============================================================================
+ * Fixed-size block pools in front of the LVGL heap
+ * =============================================================================
+ * The linker redirects every call to lv_malloc_core() / lv_realloc_core() /
+ * lv_free_core() to the __wrap_ functions below (-Wl,--wrap, see
+ * CMakeLists.txt); __real_ names reach Zephyr's original implementation.
+ *
+ * A pointer is returned to the pool whose buffer contains it, so no header
+ * is stored in front of a block.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "mem_pools.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mem_pools, LOG_LEVEL_INF);
+
+void *__real_lv_malloc_core(size_t size);
+void *__real_lv_realloc_core(void *p, size_t new_size);
+void __real_lv_free_core(void *p);
+
+/* Blocks are handed to LVGL as-is: keep them aligned like heap blocks */
+#define MEM_POOL_ALIGN 8
+
+K_MEM_SLAB_DEFINE_STATIC(mem_slab_16, 16, CONFIG_APP_MEM_POOL_16_BLOCKS,
+			 MEM_POOL_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(mem_slab_32, 32, CONFIG_APP_MEM_POOL_32_BLOCKS,
+			 MEM_POOL_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(mem_slab_64, 64, CONFIG_APP_MEM_POOL_64_BLOCKS,
+			 MEM_POOL_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(mem_slab_128, 128, CONFIG_APP_MEM_POOL_128_BLOCKS,
+			 MEM_POOL_ALIGN);
+K_MEM_SLAB_DEFINE_STATIC(mem_slab_256, 256, CONFIG_APP_MEM_POOL_256_BLOCKS,
+			 MEM_POOL_ALIGN);
+
+/* Smallest class first */
+static struct k_mem_slab *const mem_slabs[MEM_POOL_CLASSES] = {
+	&mem_slab_16, &mem_slab_32, &mem_slab_64, &mem_slab_128, &mem_slab_256,
+};
+
+static atomic_t mem_fallbacks[MEM_POOL_CLASSES];
+
+#define MEM_POOL_MAX_SIZE 256
+
+/* Index of the smallest class that holds 'size' bytes (size <= 256) */
+static inline int mem_pool_class(size_t size)
+{
+	return (size <= 16) ? 0 : (32 - __builtin_clz(size - 1)) - 4;
+}
+
+/* Class whose buffer 'p' lies in, or -1 for a heap block */
+static int mem_pool_owner(const void *p)
+{
+	for (int i = 0; i < MEM_POOL_CLASSES; i++) {
+		const struct k_mem_slab *slab = mem_slabs[i];
+		const char *start = slab->buffer;
+		const char *end = start + slab->info.block_size * slab->info.num_blocks;
+
+		if ((const char *)p >= start && (const char *)p < end) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void *__wrap_lv_malloc_core(size_t size)
+{
+	void *p;
+
+	if (size > MEM_POOL_MAX_SIZE) {
+		return __real_lv_malloc_core(size);
+	}
+
+	int cls = mem_pool_class(size);
+
+	if (k_mem_slab_alloc(mem_slabs[cls], &p, K_NO_WAIT) == 0) {
+		return p;
+	}
+
+	/* Class exhausted: still works, just not fragmentation-free */
+	atomic_inc(&mem_fallbacks[cls]);
+	return __real_lv_malloc_core(size);
+}
+
+void __wrap_lv_free_core(void *p)
+{
+	int cls = mem_pool_owner(p);
+
+	if (cls < 0) {
+		__real_lv_free_core(p);
+		return;
+	}
+
+	k_mem_slab_free(mem_slabs[cls], p);
+}
+
+void *__wrap_lv_realloc_core(void *p, size_t new_size)
+{
+	int cls = (p != NULL) ? mem_pool_owner(p) : -1;
+
+	if (p != NULL && cls < 0) {
+		/* Heap blocks stay on the heap (the heap can grow them in place) */
+		return __real_lv_realloc_core(p, new_size);
+	}
+
+	if (p == NULL) {
+		return __wrap_lv_malloc_core(new_size);
+	}
+
+	/* Still fits its block: nothing to do (LVGL's label text grows a
+	 * few bytes at a time, so this is the common case) */
+	const size_t block_size = mem_slabs[cls]->info.block_size;
+
+	if (new_size <= block_size) {
+		return p;
+	}
+
+	void *n = __wrap_lv_malloc_core(new_size);
+
+	if (n != NULL) {
+		memcpy(n, p, block_size);
+		k_mem_slab_free(mem_slabs[cls], p);
+	}
+
+	return n;
+}
+
+void mem_pools_get_stats(struct mem_pool_stats *stats)
+{
+	for (int i = 0; i < MEM_POOL_CLASSES; i++) {
+		struct k_mem_slab *slab = mem_slabs[i];
+
+		stats->cls[i].block_size = slab->info.block_size;
+		stats->cls[i].blocks = slab->info.num_blocks;
+		stats->cls[i].used = k_mem_slab_num_used_get(slab);
+		stats->cls[i].peak = k_mem_slab_max_used_get(slab);
+		stats->cls[i].fallbacks = atomic_get(&mem_fallbacks[i]);
+	}
+}
+
+void mem_pools_log(const char *tag)
+{
+	struct mem_pool_stats stats;
+
+	mem_pools_get_stats(&stats);
+	for (int i = 0; i < MEM_POOL_CLASSES; i++) {
+		LOG_INF("Pool %3u B after %s: %u/%u used, %u peak, %u to heap",
+			stats.cls[i].block_size, tag, stats.cls[i].used,
+			stats.cls[i].blocks, stats.cls[i].peak,
+			stats.cls[i].fallbacks);
+	}
+}
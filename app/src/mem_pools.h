@@ -0,0 +1,62 @@
+/*
+ * =============================================================================
+ * Fixed-size block pools in front of the LVGL heap
+ * =============================================================================
+ * Widgets are created once and kept (screen_cache.c), but LVGL still
+ * allocates and frees small blocks on every frame: draw tasks, layers,
+ * timers, animations, label text. On a general heap these short-lived
+ * blocks end up between long-lived widget objects, and after months of
+ * uptime the free space is chopped into pieces that take longer to search.
+ *
+ * With CONFIG_APP_MEM_POOLS, LVGL's allocator (lv_malloc_core() and friends,
+ * provided by Zephyr's LVGL glue) is wrapped at link time. Requests up to
+ * 256 bytes are served from one k_mem_slab per size class (16, 32, 64, 128,
+ * 256 bytes). A slab allocation is O(1) and a freed block is always reusable
+ * by the next request of its class, so these can never fragment. Larger
+ * requests, and any request whose class has run out of blocks, go to the
+ * LVGL heap as before.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_MEM_POOLS_H_
+#define APP_MEM_POOLS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MEM_POOL_CLASSES 5
+
+struct mem_pool_stats {
+	struct {
+		uint16_t block_size;
+		uint16_t blocks;
+		uint16_t used;
+		uint16_t peak;
+		uint32_t fallbacks;  /* Requests sent to the heap: class was full */
+	} cls[MEM_POOL_CLASSES];
+};
+
+#ifdef CONFIG_APP_MEM_POOLS
+
+void mem_pools_get_stats(struct mem_pool_stats *stats);
+
+/* Log the use of every size class (e.g. after a full demo cycle) */
+void mem_pools_log(const char *tag);
+
+#else
+
+static inline void mem_pools_get_stats(struct mem_pool_stats *stats)
+{
+	*stats = (struct mem_pool_stats){ 0 };
+}
+
+static inline void mem_pools_log(const char *tag)
+{
+	(void)tag;
+}
+
+#endif /* CONFIG_APP_MEM_POOLS */
+
+#endif /* APP_MEM_POOLS_H_ */
@@ -0,0 +1,243 @@
+/*
+ * =============================================================================
+ * Remote mirror of the panel contents (UART stream)
+ * =============================================================================
+ * The panel module calls in from the thread that owns LVGL, right when a
+ * frame is queued for the bus. Encoding happens there (a few microseconds
+ * per dirty page); the bytes go into a ring buffer that a low-priority
+ * thread drains to the UART, so a slow link never holds up rendering.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "mirror.h"
+#include "panel_geom.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mirror, LOG_LEVEL_INF);
+
+/* A dedicated UART if the board has one, else the console */
+#if DT_HAS_CHOSEN(app_mirror_uart)
+#define MIRROR_UART_NODE DT_CHOSEN(app_mirror_uart)
+#else
+#define MIRROR_UART_NODE DT_CHOSEN(zephyr_console)
+#endif
+
+BUILD_ASSERT(PANEL_WIDTH <= UINT8_MAX && PANEL_PAGES <= UINT8_MAX,
+	     "Geometry must fit the one-byte packet fields");
+
+#define MIRROR_SYNC0       0xA5
+#define MIRROR_SYNC1       0x5A
+#define MIRROR_FLAG_KEY    BIT(0)
+
+/* sync, flags, seq, width, pages, count */
+#define MIRROR_HDR_SIZE    8
+/* page, x1, n */
+#define MIRROR_REC_SIZE    3
+/* Longest RLE token */
+#define MIRROR_RLE_MAX     128
+
+/* Worst case: every page fully changed and incompressible, plus checksum */
+#define MIRROR_PKT_SIZE                                                     \
+	(MIRROR_HDR_SIZE +                                                  \
+	 PANEL_PAGES * (MIRROR_REC_SIZE + PANEL_WIDTH +                     \
+			DIV_ROUND_UP(PANEL_WIDTH, MIRROR_RLE_MAX)) + 1)
+
+BUILD_ASSERT(CONFIG_APP_MIRROR_BUF_SIZE >= MIRROR_PKT_SIZE,
+	     "CONFIG_APP_MIRROR_BUF_SIZE must hold at least one key frame");
+
+static const struct device *const mirror_uart = DEVICE_DT_GET(MIRROR_UART_NODE);
+
+/* --- UI thread only --------------------------------------------------------*/
+/* What the host shows once it has decoded every packet so far */
+static uint8_t mirror_shadow[PANEL_PAGES][PANEL_WIDTH];
+static uint8_t mirror_pkt[MIRROR_PKT_SIZE];
+static size_t mirror_len;
+static uint8_t mirror_count;
+static uint16_t mirror_seq;
+static bool mirror_key;
+/* The host's image is unknown (boot, or a packet was dropped) */
+static bool mirror_key_pending = true;
+static int64_t mirror_last_key_ms;
+
+/* --- Shared with the output thread (one producer, one consumer) ------------*/
+RING_BUF_DECLARE(mirror_ring, CONFIG_APP_MIRROR_BUF_SIZE);
+static K_SEM_DEFINE(mirror_sem, 0, 1);
+
+/* Run-length encode 'n' bytes. Returns the number of bytes written. */
+static size_t mirror_rle(const uint8_t *src, size_t n, uint8_t *out)
+{
+	size_t o = 0;
+	size_t i = 0;
+
+	while (i < n) {
+		size_t run = 1;
+
+		while (i + run < n && run < MIRROR_RLE_MAX &&
+		       src[i + run] == src[i]) {
+			run++;
+		}
+
+		/* Three equal bytes or more: cheaper as a repeat token */
+		if (run >= 3) {
+			out[o++] = 0x80 | (run - 1);
+			out[o++] = src[i];
+			i += run;
+			continue;
+		}
+
+		/* Literal bytes, up to the start of the next run */
+		size_t start = i;
+
+		while (i < n && i - start < MIRROR_RLE_MAX &&
+		       !(i + 2 < n && src[i] == src[i + 1] &&
+			 src[i] == src[i + 2])) {
+			i++;
+		}
+
+		out[o++] = i - start - 1;
+		memcpy(&out[o], &src[start], i - start);
+		o += i - start;
+	}
+
+	return o;
+}
+
+/* Append one page window record (XOR delta or, in a key frame, raw bytes) */
+static void mirror_add_record(int page, int x1, int n, const uint8_t *data)
+{
+	uint8_t *rec = &mirror_pkt[mirror_len];
+
+	rec[0] = page;
+	rec[1] = x1;
+	rec[2] = n;
+	mirror_len += MIRROR_REC_SIZE;
+	mirror_len += mirror_rle(data, n, &mirror_pkt[mirror_len]);
+	mirror_count++;
+}
+
+void mirror_frame_begin(void)
+{
+	int64_t now = k_uptime_get();
+
+	mirror_key = mirror_key_pending;
+	if (CONFIG_APP_MIRROR_KEYFRAME_MS > 0 &&
+	    now - mirror_last_key_ms >= CONFIG_APP_MIRROR_KEYFRAME_MS) {
+		mirror_key = true;
+	}
+
+	mirror_len = MIRROR_HDR_SIZE;
+	mirror_count = 0;
+}
+
+void mirror_page(int page, int x1, int x2, const uint8_t *cols,
+		 uint8_t xor_mask)
+{
+	uint8_t *shadow = mirror_shadow[page];
+	uint8_t delta[PANEL_WIDTH];
+	int first = -1;
+	int last = -1;
+
+	for (int x = x1; x <= x2; x++) {
+		uint8_t v = cols[x - x1] ^ xor_mask;
+
+		delta[x] = v ^ shadow[x];
+		if (delta[x] != 0U) {
+			if (first < 0) {
+				first = x;
+			}
+			last = x;
+		}
+		shadow[x] = v;
+	}
+
+	/* LVGL redrew it, but the pixels came out the same */
+	if (first < 0 || mirror_key) {
+		return;
+	}
+
+	mirror_add_record(page, first, last - first + 1, &delta[first]);
+}
+
+void mirror_frame_end(void)
+{
+	if (mirror_key) {
+		/* The whole picture, from the updated shadow */
+		mirror_len = MIRROR_HDR_SIZE;
+		mirror_count = 0;
+		for (int p = 0; p < PANEL_PAGES; p++) {
+			mirror_add_record(p, 0, PANEL_WIDTH, mirror_shadow[p]);
+		}
+	} else if (mirror_count == 0U) {
+		return;
+	}
+
+	mirror_pkt[0] = MIRROR_SYNC0;
+	mirror_pkt[1] = MIRROR_SYNC1;
+	mirror_pkt[2] = mirror_key ? MIRROR_FLAG_KEY : 0;
+	sys_put_le16(mirror_seq, &mirror_pkt[3]);
+	mirror_pkt[5] = PANEL_WIDTH;
+	mirror_pkt[6] = PANEL_PAGES;
+	mirror_pkt[7] = mirror_count;
+
+	uint8_t sum = 0;
+
+	for (size_t i = 2; i < mirror_len; i++) {
+		sum += mirror_pkt[i];
+	}
+	mirror_pkt[mirror_len++] = sum;
+
+	/* Never wait for the UART: drop the packet and resync with a key frame */
+	if (ring_buf_space_get(&mirror_ring) < mirror_len) {
+		mirror_key_pending = true;
+		return;
+	}
+
+	ring_buf_put(&mirror_ring, mirror_pkt, mirror_len);
+	k_sem_give(&mirror_sem);
+
+	mirror_seq++;
+	if (mirror_key) {
+		mirror_key_pending = false;
+		mirror_last_key_ms = k_uptime_get();
+	}
+}
+
+static void mirror_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (!device_is_ready(mirror_uart)) {
+		LOG_ERR("Mirror UART not ready");
+		return;
+	}
+
+	while (1) {
+		uint8_t chunk[32];
+		uint32_t n = ring_buf_get(&mirror_ring, chunk, sizeof(chunk));
+
+		if (n == 0U) {
+			k_sem_take(&mirror_sem, K_FOREVER);
+			continue;
+		}
+
+		for (uint32_t i = 0; i < n; i++) {
+			uart_poll_out(mirror_uart, chunk[i]);
+		}
+	}
+}
+
+K_THREAD_DEFINE(mirror_tid, CONFIG_APP_MIRROR_STACK_SIZE, mirror_thread,
+		NULL, NULL, NULL, CONFIG_APP_MIRROR_THREAD_PRIORITY, 0, 0);
@@ -0,0 +1,75 @@
+/*
+ * =============================================================================
+ * Remote mirror of the panel contents (UART stream)
+ * =============================================================================
+ * Every frame the panel module sends to the first display is also encoded
+ * as a compact delta packet and streamed out of a UART, so a host can show
+ * what is on the OLED (scripts/mirror_decode.py).
+ *
+ * Only the page windows the panel module already marked dirty are looked
+ * at, so a static screen costs nothing. Each window is compared with a copy
+ * of the last frame, trimmed to the columns that really changed, XORed with
+ * the old bytes (unchanged pixels become 0) and run-length encoded.
+ *
+ * Packet layout (all multi-byte fields little-endian):
+ *
+ *   0xA5 0x5A                   sync
+ *   flags                       bit 0: key frame (host clears its image first)
+ *   seq (u16)                   packet counter, a gap means packets were lost
+ *   width, pages                panel geometry
+ *   count                       number of page windows that follow
+ *   count x { page, x1, n, RLE data covering n columns }
+ *   checksum                    sum of all bytes from 'flags' on, mod 256
+ *
+ * RLE data is a list of tokens: a control byte c < 0x80 is followed by c + 1
+ * literal bytes; c >= 0x80 is followed by one byte repeated (c & 0x7F) + 1
+ * times. Decoded bytes are XORed into the host image, in controller format
+ * (LSB = top row of the page, 1 = pixel lit).
+ *
+ * Packets that don't fit into the output buffer are dropped and a key frame
+ * is sent next, which also happens every CONFIG_APP_MIRROR_KEYFRAME_MS.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_MIRROR_H_
+#define APP_MIRROR_H_
+
+#include <zephyr/sys/util.h>
+#include <stdint.h>
+
+#ifdef CONFIG_APP_MIRROR
+
+/* Start a packet for one frame. Called by the panel module. */
+void mirror_frame_begin(void);
+
+/*
+ * Add what the frame sends in columns [x1, x2] of page 'page'. 'cols' are
+ * the bytes written to the panel, with 'xor_mask' applied (see panel.c).
+ */
+void mirror_page(int page, int x1, int x2, const uint8_t *cols,
+		 uint8_t xor_mask);
+
+/* Finish the packet and queue it for the UART */
+void mirror_frame_end(void);
+
+#else
+
+static inline void mirror_frame_begin(void) {}
+
+static inline void mirror_page(int page, int x1, int x2, const uint8_t *cols,
+			       uint8_t xor_mask)
+{
+	ARG_UNUSED(page);
+	ARG_UNUSED(x1);
+	ARG_UNUSED(x2);
+	ARG_UNUSED(cols);
+	ARG_UNUSED(xor_mask);
+}
+
+static inline void mirror_frame_end(void) {}
+
+#endif /* CONFIG_APP_MIRROR */
+
+#endif /* APP_MIRROR_H_ */
@@ -0,0 +1,339 @@
+/*
+ * =============================================================================
+ * 1-bit arc gauge without anti-aliasing
+ * =============================================================================
+ * Coordinates are doubled and centred on the arc, so an even or an odd
+ * diameter both put every pixel centre on an integer: pixel x of a d-wide
+ * arc is at u = 2x - (d - 1). A pixel is on the ring when
+ *
+ *     r_in^2 < u^2 + v^2 <= r_out^2     (r_out = d, r_in = d - 2 * width)
+ *
+ * Row by row from the middle outwards the edge of each circle only moves
+ * inwards, so both edges are tracked with a decrement loop (the midpoint
+ * circle idea) and every row becomes one or two spans.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "mono_arc.h"
+#include "styles.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mono_arc, LOG_LEVEL_INF);
+
+/* A ring mask and the geometry it was made for */
+struct mono_arc_ring {
+	int16_t d;                /* 0 = free slot */
+	int16_t width;
+	int16_t start;
+	int16_t sweep;
+	uint16_t offset;          /* Mask start in mono_arc_pool */
+};
+
+static struct mono_arc_ring mono_arc_rings[CONFIG_APP_MONO_ARC_RINGS];
+static uint8_t mono_arc_pool[CONFIG_APP_MONO_ARC_CACHE_SIZE];
+static uint16_t mono_arc_pool_used;
+
+BUILD_ASSERT(CONFIG_APP_MONO_ARC_CACHE_SIZE <= UINT16_MAX);
+
+/* A sector: 'sweep' degrees clockwise from 'start' */
+struct mono_arc_sector {
+	int16_t sweep;
+	int32_t sx, sy;           /* Direction of the first edge */
+	int32_t ex, ey;           /* Direction of the second edge */
+};
+
+static void mono_arc_sector_init(struct mono_arc_sector *s, int16_t start,
+				 int16_t sweep)
+{
+	s->sweep = sweep;
+	s->sx = lv_trigo_cos(start);
+	s->sy = lv_trigo_sin(start);
+	s->ex = lv_trigo_cos(start + sweep);
+	s->ey = lv_trigo_sin(start + sweep);
+}
+
+/* Is the point (u, v) inside the sector? (y grows downwards, so clockwise
+ * from a to b means a positive cross product a x b) */
+static bool mono_arc_in_sector(const struct mono_arc_sector *s, int32_t u,
+			       int32_t v)
+{
+	if (s->sweep >= 360) {
+		return true;
+	}
+
+	if (s->sweep <= 0) {
+		return false;
+	}
+
+	const int32_t after_start = s->sx * v - s->sy * u;
+	const int32_t before_end = u * s->ey - v * s->ex;
+
+	if (s->sweep <= 180) {
+		return after_start >= 0 && before_end >= 0;
+	}
+
+	/* Wider than a half circle: outside the (narrow) remaining sector */
+	return !(after_start < 0 && before_end < 0);
+}
+
+static inline bool mono_arc_mask_bit(const struct mono_arc *a, int32_t x,
+				     int32_t y)
+{
+	return (a->ring[y * a->r.stride + (x >> 3)] & BIT(7 - (x & 7))) != 0;
+}
+
+/* Dotted background: every other pixel, shifted by one on every row */
+static inline bool mono_arc_bg_bit(int32_t x, int32_t y)
+{
+	return ((x + y) & 1) == 0;
+}
+
+/* Fill the ring spans of the rows y and d - 1 - y into 'mask' */
+static void mono_arc_ring_rows(const struct raster *mask, int32_t d,
+			       int32_t y, int32_t uo, int32_t ui)
+{
+	const int32_t rows[2] = { y, d - 1 - y };
+
+	for (int i = 0; i < ARRAY_SIZE(rows); i++) {
+		/* u = 2x - (d - 1), so x = (u + d - 1) / 2 */
+		const int32_t x_out_l = (d - 1 - uo) / 2;
+		const int32_t x_out_r = (d - 1 + uo) / 2;
+
+		if (ui < 0) {
+			raster_hspan(mask, x_out_l, x_out_r, rows[i], true);
+		} else {
+			raster_hspan(mask, x_out_l, (d - 1 - ui) / 2 - 1, rows[i], true);
+			raster_hspan(mask, (d - 1 + ui) / 2 + 1, x_out_r, rows[i], true);
+		}
+	}
+}
+
+static void mono_arc_ring_build(const struct mono_arc *a, uint8_t *buf,
+				int32_t d)
+{
+	const struct raster mask = {
+		.buf = buf, .w = d, .h = d, .stride = a->r.stride,
+		.cf = LV_COLOR_FORMAT_A1,
+	};
+	const int32_t ro2 = a->r_out * a->r_out;
+	const int32_t ri2 = a->r_in * a->r_in;
+	int32_t uo = d - 1;       /* Outermost u still on the outer disc */
+	int32_t ui = d - 1;       /* Outermost u still in the inner hole */
+
+	raster_fill(&mask, false);
+
+	/* Bottom half, from the middle row down; the top half is its mirror */
+	for (int32_t y = d / 2; y < d; y++) {
+		const int32_t v2 = (2 * y - (d - 1)) * (2 * y - (d - 1));
+
+		while (uo >= 0 && uo * uo + v2 > ro2) {
+			uo -= 2;
+		}
+		while (ui >= 0 && ui * ui + v2 > ri2) {
+			ui -= 2;
+		}
+
+		if (uo < 0) {
+			break;
+		}
+
+		mono_arc_ring_rows(&mask, d, y, uo, a->r_in > 0 ? ui : -1);
+	}
+
+	if (a->sweep >= 360) {
+		return;
+	}
+
+	/* Clip to the background angles (once per geometry) */
+	struct mono_arc_sector s;
+
+	mono_arc_sector_init(&s, a->start, a->sweep);
+	for (int32_t y = 0; y < d; y++) {
+		for (int32_t x = 0; x < d; x++) {
+			if (!mono_arc_in_sector(&s, 2 * x - (d - 1), 2 * y - (d - 1))) {
+				raster_pixel(&mask, x, y, false);
+			}
+		}
+	}
+}
+
+/* Find or make the ring mask for this geometry */
+static const uint8_t *mono_arc_ring_get(const struct mono_arc *a, int32_t d,
+					int32_t width)
+{
+	const uint32_t size = a->r.stride * d;
+
+	for (int i = 0; i < ARRAY_SIZE(mono_arc_rings); i++) {
+		struct mono_arc_ring *ring = &mono_arc_rings[i];
+
+		if (ring->d == d && ring->width == width &&
+		    ring->start == a->start && ring->sweep == a->sweep) {
+			return &mono_arc_pool[ring->offset];
+		}
+
+		if (ring->d != 0) {
+			continue;
+		}
+
+		/* Masks are never evicted: the arcs keep drawing from them */
+		if (mono_arc_pool_used + size > sizeof(mono_arc_pool)) {
+			break;
+		}
+
+		*ring = (struct mono_arc_ring){
+			.d = d, .width = width, .start = a->start, .sweep = a->sweep,
+			.offset = mono_arc_pool_used,
+		};
+		mono_arc_pool_used += size;
+		mono_arc_ring_build(a, &mono_arc_pool[ring->offset], d);
+		return &mono_arc_pool[ring->offset];
+	}
+
+	return NULL;
+}
+
+/* Bounding box (in pixels) of the ring part of a sector */
+static void mono_arc_sector_box(const struct mono_arc *a, int16_t start,
+				int16_t sweep, lv_area_t *box)
+{
+	const int32_t d = a->r.w;
+	/* Extreme points: both edges on both circles, plus the outer circle
+	 * at every axis the sector crosses */
+	int32_t u1 = INT32_MAX, v1 = INT32_MAX, u2 = INT32_MIN, v2 = INT32_MIN;
+	const int16_t radii[2] = { a->r_out, MAX(a->r_in, 0) };
+	const int16_t edges[2] = { start, start + sweep };
+
+	for (int i = 0; i < ARRAY_SIZE(edges); i++) {
+		for (int j = 0; j < ARRAY_SIZE(radii); j++) {
+			const int32_t u = (lv_trigo_cos(edges[i]) * radii[j]) >>
+					  LV_TRIGO_SHIFT;
+			const int32_t v = (lv_trigo_sin(edges[i]) * radii[j]) >>
+					  LV_TRIGO_SHIFT;
+
+			u1 = MIN(u1, u);
+			u2 = MAX(u2, u);
+			v1 = MIN(v1, v);
+			v2 = MAX(v2, v);
+		}
+	}
+
+	for (int16_t axis = 0; axis < 720; axis += 90) {
+		if (axis > start && axis < start + sweep) {
+			const int32_t u = (lv_trigo_cos(axis) * a->r_out) >> LV_TRIGO_SHIFT;
+			const int32_t v = (lv_trigo_sin(axis) * a->r_out) >> LV_TRIGO_SHIFT;
+
+			u1 = MIN(u1, u);
+			u2 = MAX(u2, u);
+			v1 = MIN(v1, v);
+			v2 = MAX(v2, v);
+		}
+	}
+
+	/* One pixel of margin for the rounding of the edge directions */
+	box->x1 = CLAMP((u1 + d - 1) / 2 - 1, 0, d - 1);
+	box->x2 = CLAMP((u2 + d - 1) / 2 + 1, 0, d - 1);
+	box->y1 = CLAMP((v1 + d - 1) / 2 - 1, 0, d - 1);
+	box->y2 = CLAMP((v2 + d - 1) / 2 + 1, 0, d - 1);
+}
+
+/* Redraw the ring pixels of one sector, solid or dotted */
+static void mono_arc_draw_sector(struct mono_arc *a, int16_t start,
+				 int16_t sweep, bool solid)
+{
+	const int32_t d = a->r.w;
+	struct mono_arc_sector s;
+	lv_area_t box;
+	lv_area_t coords;
+
+	mono_arc_sector_init(&s, start, sweep);
+	mono_arc_sector_box(a, start, sweep, &box);
+
+	for (int32_t y = box.y1; y <= box.y2; y++) {
+		for (int32_t x = box.x1; x <= box.x2; x++) {
+			if (mono_arc_mask_bit(a, x, y) &&
+			    mono_arc_in_sector(&s, 2 * x - (d - 1), 2 * y - (d - 1))) {
+				raster_pixel(&a->r, x, y, solid || mono_arc_bg_bit(x, y));
+			}
+		}
+	}
+
+	/* Only the changed part of the canvas needs rendering and sending */
+	lv_obj_get_coords(a->canvas, &coords);
+	lv_area_move(&box, coords.x1, coords.y1);
+	lv_obj_invalidate_area(a->canvas, &box);
+}
+
+int mono_arc_init(struct mono_arc *a, lv_obj_t *parent, uint8_t *buf,
+		  int32_t d, int32_t width, int16_t start, int16_t end)
+{
+	const int16_t sweep = ((end - start) % 360 + 360) % 360;
+
+	a->canvas = lv_canvas_create(parent);
+	lv_canvas_set_buffer(a->canvas, buf, d, d, LV_COLOR_FORMAT_A1);
+	styles_apply(a->canvas, STYLE_MONO_IMAGE);
+
+	if (raster_from_canvas(&a->r, a->canvas) != 0) {
+		return -ENOTSUP;
+	}
+
+	a->start = ((start % 360) + 360) % 360;
+	a->sweep = (sweep == 0) ? 360 : sweep;
+	a->min = 0;
+	a->max = 100;
+	a->value = 0;
+	a->drawn = 0;
+	a->r_out = d;
+	a->r_in = d - 2 * width;
+
+	a->ring = mono_arc_ring_get(a, d, width);
+	if (a->ring == NULL) {
+		LOG_WRN("Arc ring cache full (%d x %d)", d, d);
+		return -ENOMEM;
+	}
+
+	/* Start with the whole background dotted */
+	for (int32_t y = 0; y < d; y++) {
+		const uint8_t *mask = &a->ring[y * a->r.stride];
+		uint8_t *row = &a->r.buf[y * a->r.stride];
+		const uint8_t dots = (y & 1) ? 0x55 : 0xAA;
+
+		for (uint32_t i = 0; i < a->r.stride; i++) {
+			row[i] = mask[i] & dots;
+		}
+	}
+
+	lv_obj_invalidate(a->canvas);
+	return 0;
+}
+
+void mono_arc_set_range(struct mono_arc *a, int16_t min, int16_t max)
+{
+	a->min = min;
+	a->max = MAX(max, min + 1);
+	mono_arc_set_value(a, a->value);
+}
+
+void mono_arc_set_value(struct mono_arc *a, int16_t value)
+{
+	a->value = CLAMP(value, a->min, a->max);
+
+	const int16_t angle = (int32_t)a->sweep * (a->value - a->min) /
+			      (a->max - a->min);
+
+	/* Only the sector between the old and the new end changes */
+	if (angle > a->drawn) {
+		mono_arc_draw_sector(a, a->start + a->drawn, angle - a->drawn, true);
+	} else if (angle < a->drawn) {
+		mono_arc_draw_sector(a, a->start + angle, a->drawn - angle, false);
+	}
+
+	a->drawn = angle;
+}
@@ -0,0 +1,71 @@
+/*
+ * =============================================================================
+ * 1-bit arc gauge without anti-aliasing
+ * =============================================================================
+ * lv_arc draws its rings with LVGL's anti-aliased arc renderer: per-pixel
+ * coverage, alpha blending and rounded caps, all of which end up as plain
+ * on/off on this panel. A mono arc is an A1 canvas instead, rasterized
+ * with integers only:
+ *
+ *   - the ring is built from per-row spans of two midpoint circles (outer
+ *     and inner edge) and clipped to the background angle range once;
+ *     that mask is cached and shared by every arc of the same geometry
+ *   - the background shows as a dotted ring, the value sweep as a solid
+ *     one; angles are tested with cross products against the two edge
+ *     directions, no atan
+ *   - mono_arc_set_value() only re-rasterizes the sector between the old
+ *     and the new value, and only invalidates that sector's bounding box
+ *
+ * Angles follow lv_arc: degrees, 0 = 3 o'clock, growing clockwise.
+ *
+ * Usage:
+ *     static uint8_t buf[MONO_ARC_BUF_SIZE(50)];
+ *     static struct mono_arc arc;
+ *     mono_arc_init(&arc, scr, buf, 50, 6, 0, 270);
+ *     mono_arc_set_value(&arc, 75);
+ *     lv_obj_align(arc.canvas, LV_ALIGN_CENTER, 0, 0);
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_MONO_ARC_H_
+#define APP_MONO_ARC_H_
+
+#include <lvgl.h>
+#include <stdint.h>
+
+#include "raster.h"
+
+/* Canvas buffer for a d x d arc */
+#define MONO_ARC_BUF_SIZE(d) LV_CANVAS_BUF_SIZE(d, d, 1, 1)
+
+struct mono_arc {
+	lv_obj_t *canvas;
+	struct raster r;          /* The canvas pixels */
+	const uint8_t *ring;      /* Cached ring mask, laid out like r.buf */
+	int16_t start;            /* Background start angle */
+	int16_t sweep;            /* Background length, 1..360 degrees */
+	int16_t min;
+	int16_t max;
+	int16_t value;
+	int16_t drawn;            /* Degrees of the sweep currently drawn solid */
+	int16_t r_out;            /* Radii in half pixels */
+	int16_t r_in;
+};
+
+/*
+ * Create a d x d arc with a ring 'width' pixels wide on 'parent', drawn
+ * into 'buf' (MONO_ARC_BUF_SIZE(d) bytes). The background covers the
+ * angles start..end (end == start is a full circle). Range 0..100, value
+ * 0. Returns 0, or -ENOMEM when the ring cache is full. Call from the
+ * thread that owns LVGL.
+ */
+int mono_arc_init(struct mono_arc *a, lv_obj_t *parent, uint8_t *buf,
+		  int32_t d, int32_t width, int16_t start, int16_t end);
+
+void mono_arc_set_range(struct mono_arc *a, int16_t min, int16_t max);
+
+void mono_arc_set_value(struct mono_arc *a, int16_t value);
+
+#endif /* APP_MONO_ARC_H_ */
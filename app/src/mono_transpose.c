@@ -0,0 +1,119 @@
+/*
+ * =============================================================================
+ * 1-bit row-major -> page (vertical byte) conversion
+ * =============================================================================
+ * The 8x8 block kernel itself (mono_transpose8) is in the header, so
+ * callers that know the frame stride at compile time get it inlined with
+ * constant row offsets.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "mono_transpose.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(mono_transpose, LOG_LEVEL_INF);
+
+void mono_transpose_page(const uint8_t *rows, uint32_t stride, int x1, int x2,
+			 uint8_t *out, uint8_t xor_mask)
+{
+	const int last = x2 >> 3;
+	uint8_t tail[8];
+
+	for (int bx = x1 >> 3; bx < last; bx++) {
+		mono_transpose8(rows + bx, stride, out + (bx << 3), xor_mask);
+	}
+
+	/* The last block may reach past x2, and past the end of out[] */
+	if ((x2 & 7) == 7) {
+		mono_transpose8(rows + last, stride, out + (last << 3), xor_mask);
+	} else {
+		mono_transpose8(rows + last, stride, tail, xor_mask);
+		memcpy(out + (last << 3), tail, (x2 & 7) + 1);
+	}
+}
+
+void mono_transpose_page_ref(const uint8_t *rows, uint32_t stride, int x1,
+			     int x2, uint8_t *out, uint8_t xor_mask)
+{
+	for (int x = x1; x <= x2; x++) {
+		const uint8_t bit = BIT(7 - (x & 7));
+		const uint8_t *src = rows + (x >> 3);
+		uint8_t col = 0;
+
+		for (int r = 0; r < 8; r++) {
+			if (src[r * stride] & bit) {
+				col |= BIT(r);
+			}
+		}
+		out[x] = col ^ xor_mask;
+	}
+}
+
+#ifdef CONFIG_APP_TRANSPOSE_BENCH
+#include <zephyr/timing/timing.h>
+
+/* Largest frame the benchmark handles: 128x64 at 1 bpp */
+#define BENCH_MAX_BYTES (128 * 64 / 8)
+
+typedef void (*transpose_fn)(const uint8_t *, uint32_t, int, int, uint8_t *,
+			     uint8_t);
+
+static uint64_t bench_one(transpose_fn fn, const uint8_t *fb, uint8_t *out,
+			  uint16_t width, uint16_t height)
+{
+	const uint32_t stride = width / 8;
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (int page = 0; page < height / 8; page++) {
+		fn(fb + page * 8 * stride, stride, 0, width - 1,
+		   out + page * width, 0x00);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end);
+}
+
+void mono_transpose_bench(uint16_t width, uint16_t height)
+{
+	static uint8_t fb[BENCH_MAX_BYTES];
+	static uint8_t out_ref[BENCH_MAX_BYTES];
+	static uint8_t out_fast[BENCH_MAX_BYTES];
+
+	if ((width * height / 8) > BENCH_MAX_BYTES) {
+		LOG_WRN("Frame too large for benchmark");
+		return;
+	}
+
+	/* Any non-trivial pattern will do; this one is cheap to generate */
+	for (int i = 0; i < ARRAY_SIZE(fb); i++) {
+		fb[i] = (uint8_t)(i * 37U + (i >> 3));
+	}
+
+	timing_init();
+	timing_start();
+
+	uint64_t ref = bench_one(mono_transpose_page_ref, fb, out_ref,
+				 width, height);
+	uint64_t fast = bench_one(mono_transpose_page, fb, out_fast,
+				  width, height);
+
+	/* The counter is left running: the perf module may be using it too */
+
+	LOG_INF("Transpose %ux%u: ref %llu cycles, 8x8 block %llu cycles%s",
+		width, height, ref, fast,
+		memcmp(out_ref, out_fast, width * height / 8) ? " (MISMATCH)" : "");
+}
+#else
+void mono_transpose_bench(uint16_t width, uint16_t height)
+{
+	ARG_UNUSED(width);
+	ARG_UNUSED(height);
+}
+#endif /* CONFIG_APP_TRANSPOSE_BENCH */
@@ -0,0 +1,121 @@
+/*
+ * =============================================================================
+ * Const 1-bit images in the panel's own page format
+ * =============================================================================
+ * Every image object is kept in a small table. On each converted page the
+ * panel calls page_image_blit(), which walks the table and, for images on
+ * the active screen of that display that cross the page, combines two
+ * source pages per column:
+ *
+ *   screen page p, image top at y:   d = p * 8 - y
+ *   d < 0:   image page 0, shifted down by -d
+ *   d >= 0:  image page d / 8 shifted up by d % 8, plus the next image page
+ *            shifted down to fill the bottom rows
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+
+#include "page_image.h"
+#include "panel.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(page_image, LOG_LEVEL_INF);
+
+struct page_image_obj {
+	lv_obj_t *obj;            /* NULL = free slot */
+	const struct page_image *img;
+};
+
+/* Only touched from the LVGL thread (builds and flush callbacks) */
+static struct page_image_obj page_image_objs[CONFIG_APP_PAGE_IMAGE_MAX];
+
+static void page_image_delete_cb(lv_event_t *e)
+{
+	struct page_image_obj *o = lv_event_get_user_data(e);
+
+	o->obj = NULL;
+	o->img = NULL;
+}
+
+lv_obj_t *page_image_create(lv_obj_t *parent, const struct page_image *img)
+{
+	for (int i = 0; i < ARRAY_SIZE(page_image_objs); i++) {
+		struct page_image_obj *o = &page_image_objs[i];
+
+		if (o->obj != NULL) {
+			continue;
+		}
+
+		/* An unstyled object: LVGL lays it out but draws nothing */
+		o->obj = lv_obj_create(parent);
+		o->img = img;
+		lv_obj_remove_style_all(o->obj);
+		lv_obj_set_size(o->obj, img->w, img->h);
+		lv_obj_add_event_cb(o->obj, page_image_delete_cb, LV_EVENT_DELETE, o);
+		return o->obj;
+	}
+
+	LOG_WRN("No page image slot left");
+	return NULL;
+}
+
+/* Image column bits that land on the screen page whose top row is d below
+ * the image top */
+static inline uint8_t page_image_column(const struct page_image *img, int d,
+					int x)
+{
+	const int pages = (img->h + PANEL_PAGE_ROWS - 1) / PANEL_PAGE_ROWS;
+	const uint8_t *col = &img->data[x];
+
+	if (d < 0) {
+		return (uint8_t)(col[0] << -d);
+	}
+
+	const int ip = d / PANEL_PAGE_ROWS;
+	const int shift = d % PANEL_PAGE_ROWS;
+	uint8_t bits = col[ip * img->w] >> shift;
+
+	if (shift != 0 && ip + 1 < pages) {
+		bits |= (uint8_t)(col[(ip + 1) * img->w] << (PANEL_PAGE_ROWS - shift));
+	}
+
+	return bits;
+}
+
+void page_image_blit(lv_display_t *disp, int page, int x1, int x2,
+		     uint8_t *out, uint8_t xor_mask)
+{
+	lv_obj_t *scr = lv_display_get_screen_active(disp);
+
+	for (int i = 0; i < ARRAY_SIZE(page_image_objs); i++) {
+		const struct page_image_obj *o = &page_image_objs[i];
+		lv_area_t a;
+
+		if (o->obj == NULL || lv_obj_get_screen(o->obj) != scr ||
+		    lv_obj_has_flag(o->obj, LV_OBJ_FLAG_HIDDEN)) {
+			continue;
+		}
+
+		lv_obj_get_coords(o->obj, &a);
+
+		const int d = page * PANEL_PAGE_ROWS - a.y1;
+		const int cx1 = MAX(x1, a.x1);
+		const int cx2 = MIN(x2, a.x1 + o->img->w - 1);
+
+		if (d <= -PANEL_PAGE_ROWS || d >= o->img->h || cx1 > cx2) {
+			continue;
+		}
+
+		for (int x = cx1; x <= cx2; x++) {
+			const uint8_t bits = page_image_column(o->img, d, x - a.x1);
+
+			/* Lit pixels, in whatever polarity the frame uses */
+			out[x] = xor_mask ? (out[x] & ~bits) : (out[x] | bits);
+		}
+	}
+}
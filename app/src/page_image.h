@@ -0,0 +1,72 @@
+/*
+ * =============================================================================
+ * Const 1-bit images in the panel's own page format
+ * =============================================================================
+ * An A1 image handed to lv_image goes through LVGL's decoder and blender
+ * into the render buffer, and is then transposed back into pages like any
+ * other pixel. A page image skips all of that: it is stored in flash in the
+ * SH1106 GDDRAM layout (8-row pages, one byte per column, bit 0 on top),
+ * and the panel module ORs its bytes into the converted frame. A y that is
+ * not a multiple of 8 costs one shift per byte; nothing is copied to RAM.
+ *
+ * page_image_create() gives the image an LVGL object of its size. LVGL
+ * draws nothing for it, but it is laid out, aligned, hidden and moved like
+ * any widget, and that invalidates the right pages when it changes.
+ *
+ * scripts/png2page.py makes a page image out of a PNG; the build runs it on
+ * app/assets/ (see CMakeLists.txt), e.g. assets/smiley.png -> "smiley.h".
+ *
+ * Like an A1 image, 1 bits are lit and 0 bits transparent. Only the owning
+ * display's frame gets the image; the mirror stream and capture display see
+ * it as part of that frame.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_PAGE_IMAGE_H_
+#define APP_PAGE_IMAGE_H_
+
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+#include <stdint.h>
+
+struct page_image {
+	uint16_t w;
+	uint8_t h;
+	const uint8_t *data;      /* (h + 7) / 8 pages of w bytes */
+};
+
+#ifdef CONFIG_APP_PAGE_IMAGE
+
+/*
+ * Create an object showing 'img' (which must stay valid, normally const).
+ * Returns NULL when all CONFIG_APP_PAGE_IMAGE_MAX slots are in use.
+ * Call from the thread that owns LVGL.
+ */
+lv_obj_t *page_image_create(lv_obj_t *parent, const struct page_image *img);
+
+/*
+ * Panel hook: OR the visible page images of 'disp' into columns [x1, x2]
+ * of page 'page'. 'out' is indexed by column and already holds the
+ * converted LVGL pixels, XORed with 'xor_mask'.
+ */
+void page_image_blit(lv_display_t *disp, int page, int x1, int x2,
+		     uint8_t *out, uint8_t xor_mask);
+
+#else
+
+static inline void page_image_blit(lv_display_t *disp, int page, int x1,
+				   int x2, uint8_t *out, uint8_t xor_mask)
+{
+	ARG_UNUSED(disp);
+	ARG_UNUSED(page);
+	ARG_UNUSED(x1);
+	ARG_UNUSED(x2);
+	ARG_UNUSED(out);
+	ARG_UNUSED(xor_mask);
+}
+
+#endif /* CONFIG_APP_PAGE_IMAGE */
+
+#endif /* APP_PAGE_IMAGE_H_ */
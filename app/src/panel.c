@@ -0,0 +1,940 @@
+/*
+ * =============================================================================
+ * SH1106 panel flush engine
+ * =============================================================================
+ * How it works:
+ *
+ *   1. LVGL renders into one full-frame buffer in "direct" mode. That buffer
+ *      always holds the complete current picture, so after a refresh we can
+ *      read any pixel of it, not only the ones LVGL just redrew.
+ *   2. For every area LVGL redraws, we widen it to whole 8-row pages and mark
+ *      the touched column range of each page as "dirty".
+ *   3. When LVGL reports the last area of a refresh cycle, every dirty page
+ *      window is converted from LVGL's row-major 1-bit layout into the
+ *      controller's vertical-byte layout (8x8 block transpose, see
+ *      mono_transpose.c) and stored in a "frame" buffer.
+ *   4. The frame is handed to the flush thread, which writes the page windows
+ *      with display_write(). LVGL is told the render buffer is free right
+ *      away, so it can draw frame N+1 while frame N is still on the wire.
+ *
+ * The application can also own one page window (panel_overlay_set()): its
+ * bytes replace whatever LVGL drew there and can be resent on their own,
+ * without an LVGL refresh. The marquee (marquee.c) moves text that way.
+ * Page images (page_image.c) are ORed into each converted page before that.
+ *
+ * With CONFIG_APP_PANEL_SHADOW a copy of the panel's display RAM is kept,
+ * and each finished frame is compared with it before it is queued: pages
+ * that LVGL redrew to the same bytes are dropped, and the others trimmed
+ * to the columns that really changed.
+ *
+ * Strip render mode (CONFIG_APP_PANEL_STRIP_RENDER) trades the full-frame
+ * buffer for one just CONFIG_APP_PANEL_STRIP_PAGES pages tall. LVGL's
+ * invalidated areas are rounded to whole pages, LVGL renders them one strip
+ * at a time in "partial" mode, and each strip is converted and queued as its
+ * own frame as soon as it is drawn. Steps 1-3 above then do not apply.
+ *
+ * Two frame buffers are used (double buffering). If both are still being
+ * sent when LVGL finishes yet another frame, the flush callback waits for
+ * one to come back, which naturally limits LVGL to the speed of the bus.
+ *
+ * The Zephyr SSD1306/SH1106 driver (or panel_bus.c, with
+ * CONFIG_APP_PANEL_SPI_BATCH) adds the devicetree "segment-offset" and
+ * "page-offset" to the window position, so we only ever work in visible
+ * screen coordinates here.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "mirror.h"
+#include "mono_transpose.h"
+#include "page_image.h"
+#include "panel.h"
+#include "panel_bus.h"
+#include "perf.h"
+#include "spi_tune.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(panel, LOG_LEVEL_INF);
+
+/* Panel geometry (PANEL_WIDTH, PANEL_PAGES, ...) is in panel_geom.h */
+BUILD_ASSERT((PANEL_HEIGHT % PANEL_PAGE_ROWS) == 0,
+	     "Panel height must be a whole number of 8-row pages");
+
+/* LVGL 9 puts a 2-entry palette (2 x 4 bytes) in front of I1 pixel data */
+#define PANEL_I1_PALETTE_SIZE 8
+
+/* Frames in flight: one being sent, one being filled */
+#define PANEL_NUM_FRAMES (IS_ENABLED(CONFIG_APP_PANEL_ASYNC_FLUSH) ? 2 : 1)
+
+#ifdef CONFIG_APP_PANEL_STRIP_RENDER
+BUILD_ASSERT(CONFIG_APP_PANEL_STRIP_PAGES <= PANEL_PAGES,
+	     "A strip cannot be taller than the panel");
+
+/* A frame holds one strip; the render buffer holds one strip of I1 rows */
+#define PANEL_FRAME_PAGES CONFIG_APP_PANEL_STRIP_PAGES
+#define PANEL_STRIP_VDB_SIZE                                                 \
+	(PANEL_I1_PALETTE_SIZE +                                             \
+	 PANEL_FB_STRIDE * PANEL_PAGE_ROWS * CONFIG_APP_PANEL_STRIP_PAGES)
+#else
+#define PANEL_FRAME_PAGES PANEL_PAGES
+#endif
+
+#ifdef CONFIG_APP_PANEL_SHADOW
+/* Every page row must start on a word for the word-wise compare */
+BUILD_ASSERT((PANEL_WIDTH % sizeof(uint32_t)) == 0,
+	     "CONFIG_APP_PANEL_SHADOW needs a panel width multiple of 4");
+BUILD_ASSERT(PANEL_PAGES <= ATOMIC_BITS);
+#endif
+
+/* Column range [x1, x2] of one page that must be resent. x1 > x2 = clean. */
+struct panel_span {
+	int16_t x1;
+	int16_t x2;
+};
+
+struct panel;
+
+/*
+ * One converted frame: the dirty windows and their controller-format bytes.
+ * It stores pages [page0, page0 + PANEL_FRAME_PAGES): the whole panel, or
+ * one strip in strip-render mode. Pages outside that range are never dirty.
+ */
+struct panel_frame {
+	struct panel *owner;
+	struct panel_span dirty[PANEL_PAGES];
+	int page0;
+	/* Rendered for a button press: report it once sent (perf input) */
+	bool input;
+	uint8_t pages[PANEL_FRAME_PAGES][PANEL_WIDTH] __aligned(4);
+};
+
+/* One SH1106: its LVGL display, the Zephyr device and its frame buffers */
+struct panel {
+	lv_display_t *disp;
+	const struct device *dev;
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+	struct panel_bus *bus;
+#endif
+	/* 0xFF when the driver expects 1 = black (PIXEL_FORMAT_MONO10) */
+	uint8_t xor_mask;
+	/* Dirty spans collected while LVGL flushes the areas of one refresh */
+	struct panel_span dirty[PANEL_PAGES];
+	struct panel_stats stats;
+	struct panel_frame frames[PANEL_NUM_FRAMES];
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+	/* Frames of this panel that are free to be filled */
+	struct k_msgq free_q;
+	struct panel_frame *free_q_buf[PANEL_NUM_FRAMES];
+#endif
+#ifdef CONFIG_APP_PANEL_STRIP_RENDER
+	/* LVGL render buffer: palette + one strip */
+	uint8_t vdb[PANEL_STRIP_VDB_SIZE] __aligned(LV_DRAW_BUF_ALIGN);
+#endif
+	/* Pages the controller drives (panel_set_active_pages); the others
+	 * are dark and never sent */
+	int8_t page_first;
+	int8_t page_last;
+	/* Last panel_set_drive() contrast, -1 = devicetree default */
+	int16_t contrast;
+#ifdef CONFIG_APP_PANEL_SHADOW
+	/* What the display RAM holds once the queued frames are sent */
+	uint8_t shadow[PANEL_PAGES][PANEL_WIDTH] __aligned(4);
+	/* Pages whose shadow is not known to match (boot, failed write) */
+	atomic_t shadow_stale;
+#endif
+	/* Page window owned by the application (panel_overlay_set) */
+	struct {
+		const uint8_t *cols;      /* NULL = no overlay */
+		int16_t page;
+		int16_t x1;
+		int16_t x2;
+	} overlay;
+};
+
+/* panels[0] is the zephyr,display panel, panels[1] the optional second one */
+static struct panel panels[PANEL_COUNT];
+static int panel_count;
+
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+/* SPI bus, chip select and DC pin of each panel, in panels[] order. The
+ * clock is set at boot (spi_tune.c). */
+static struct panel_bus panel_buses[PANEL_COUNT] = {
+	PANEL_BUS_DT_SPEC_GET(PANEL_NODE),
+#ifdef PANEL2_NODE
+	PANEL_BUS_DT_SPEC_GET(PANEL2_NODE),
+#endif
+};
+#endif
+
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+/*
+ * Frames waiting for the bus, from all panels, in the order they were
+ * finished. This is the bus scheduler: while the flush thread sends one
+ * panel's frame, LVGL renders the other panel's next frame.
+ */
+K_MSGQ_DEFINE(panel_send_q, sizeof(struct panel_frame *),
+	      PANEL_COUNT * PANEL_NUM_FRAMES, 4);
+#endif
+
+/* Controller bytes of page p (which must be inside the frame) */
+static inline uint8_t *panel_frame_page(struct panel_frame *frame, int p)
+{
+	return frame->pages[p - frame->page0];
+}
+
+static void panel_clear_spans(struct panel_span *spans)
+{
+	for (int p = 0; p < PANEL_PAGES; p++) {
+		spans[p].x1 = PANEL_WIDTH;
+		spans[p].x2 = -1;
+	}
+}
+
+/* Widen an LVGL area to whole pages and merge it into the dirty spans */
+static void panel_mark_dirty(struct panel *panel, const lv_area_t *area)
+{
+	int32_t x1 = CLAMP(area->x1, 0, PANEL_WIDTH - 1);
+	int32_t x2 = CLAMP(area->x2, 0, PANEL_WIDTH - 1);
+	int32_t p1 = CLAMP(area->y1, 0, PANEL_HEIGHT - 1) / PANEL_PAGE_ROWS;
+	int32_t p2 = CLAMP(area->y2, 0, PANEL_HEIGHT - 1) / PANEL_PAGE_ROWS;
+
+	for (int32_t p = MAX(p1, panel->page_first);
+	     p <= MIN(p2, panel->page_last); p++) {
+		panel->dirty[p].x1 = MIN(panel->dirty[p].x1, x1);
+		panel->dirty[p].x2 = MAX(panel->dirty[p].x2, x2);
+	}
+}
+
+/* Replace the part of page p's dirty window that the overlay covers */
+static void panel_apply_overlay(struct panel_frame *frame, int p)
+{
+	const struct panel *panel = frame->owner;
+	const struct panel_span *span = &frame->dirty[p];
+
+	if (panel->overlay.cols == NULL || panel->overlay.page != p) {
+		return;
+	}
+
+	for (int x = MAX(span->x1, panel->overlay.x1);
+	     x <= MIN(span->x2, panel->overlay.x2); x++) {
+		panel_frame_page(frame, p)[x] =
+			panel->overlay.cols[x - panel->overlay.x1] ^
+			panel->xor_mask;
+	}
+}
+
+#if PANEL_GEOM_FIXED
+/*
+ * Specialized conversion for this panel: the stride, the page pitch and the
+ * number of blocks are constants, so the kernel is inlined with immediate
+ * row offsets, and a full-width page (the common case after a screen
+ * switch) is a loop with constant bounds.
+ */
+static inline void panel_transpose_page(const uint8_t *fb, int p,
+					const struct panel_span *span,
+					uint8_t *out, uint8_t xor_mask)
+{
+	const uint8_t *rows = fb + p * PANEL_PAGE_ROWS * PANEL_FB_STRIDE;
+
+	if (span->x1 == 0 && span->x2 == PANEL_WIDTH - 1) {
+		for (int bx = 0; bx < PANEL_BLOCKS; bx++) {
+			mono_transpose8(rows + bx, PANEL_FB_STRIDE, out + bx * 8,
+					xor_mask);
+		}
+		return;
+	}
+
+	for (int bx = span->x1 >> 3; bx <= (span->x2 >> 3); bx++) {
+		mono_transpose8(rows + bx, PANEL_FB_STRIDE, out + bx * 8,
+				xor_mask);
+	}
+}
+#endif /* PANEL_GEOM_FIXED */
+
+/* Copy the dirty windows of the finished LVGL frame into a panel frame */
+static void panel_fill_frame(struct panel_frame *frame, const uint8_t *fb,
+			     uint32_t stride)
+{
+	struct panel *panel = frame->owner;
+	perf_ts_t start = perf_now();
+
+	ARG_UNUSED(stride);    /* Only the generic path needs it */
+
+	frame->page0 = 0;
+	for (int p = 0; p < PANEL_PAGES; p++) {
+		const struct panel_span *span = &panel->dirty[p];
+
+		frame->dirty[p] = *span;
+		if (span->x1 <= span->x2) {
+#if PANEL_GEOM_FIXED
+			panel_transpose_page(fb, p, span,
+					     panel_frame_page(frame, p),
+					     panel->xor_mask);
+#else
+			/* Generic path: any width, stride known at run time */
+			mono_transpose_page(fb + p * PANEL_PAGE_ROWS * stride,
+					    stride, span->x1, span->x2,
+					    panel_frame_page(frame, p),
+					    panel->xor_mask);
+#endif
+			page_image_blit(panel->disp, p, span->x1, span->x2,
+					panel_frame_page(frame, p), panel->xor_mask);
+			panel_apply_overlay(frame, p);
+		}
+	}
+
+	panel_clear_spans(panel->dirty);
+	perf_record(PERF_TRANSPOSE, start);
+}
+
+#ifdef CONFIG_APP_PANEL_SHADOW
+/* First column in [x1, x2] where a and b differ, or -1 */
+static int panel_shadow_first(const uint8_t *a, const uint8_t *b, int x1, int x2)
+{
+	int x = x1;
+
+	/* Bytes up to a word boundary, then whole words */
+	for (; x <= x2 && (x & 3) != 0; x++) {
+		if (a[x] != b[x]) {
+			return x;
+		}
+	}
+	for (; x + 3 <= x2; x += 4) {
+		if (*(const uint32_t *)&a[x] != *(const uint32_t *)&b[x]) {
+			break;
+		}
+	}
+	for (; x <= x2; x++) {
+		if (a[x] != b[x]) {
+			return x;
+		}
+	}
+
+	return -1;
+}
+
+/* Last column in [x1, x2] where a and b differ (a[x1] != b[x1]) */
+static int panel_shadow_last(const uint8_t *a, const uint8_t *b, int x1, int x2)
+{
+	int x = x2;
+
+	for (; x > x1 && ((x + 1) & 3) != 0; x--) {
+		if (a[x] != b[x]) {
+			return x;
+		}
+	}
+	for (; x - 3 > x1; x -= 4) {
+		if (*(const uint32_t *)&a[x - 3] != *(const uint32_t *)&b[x - 3]) {
+			break;
+		}
+	}
+	for (; x > x1; x--) {
+		if (a[x] != b[x]) {
+			return x;
+		}
+	}
+
+	return x1;
+}
+
+/*
+ * Shrink the dirty windows of a finished frame to what differs from the
+ * display RAM, and note the new contents in the shadow. Only the thread that
+ * owns LVGL fills frames, so only it touches the shadow; the flush thread
+ * just marks pages stale when a write fails.
+ */
+static void panel_shadow_trim(struct panel_frame *frame)
+{
+	struct panel *panel = frame->owner;
+
+	for (int p = 0; p < PANEL_PAGES; p++) {
+		struct panel_span *span = &frame->dirty[p];
+		uint8_t *shadow = panel->shadow[p];
+		const uint8_t *page;
+
+		if (span->x1 > span->x2) {
+			continue;
+		}
+
+		page = panel_frame_page(frame, p);
+
+		if (atomic_test_bit(&panel->shadow_stale, p)) {
+			/* Send it all; a full-width window makes the page known */
+			if (span->x1 == 0 && span->x2 == PANEL_WIDTH - 1) {
+				atomic_clear_bit(&panel->shadow_stale, p);
+			}
+			memcpy(&shadow[span->x1], &page[span->x1],
+			       span->x2 - span->x1 + 1);
+			continue;
+		}
+
+		const int first = panel_shadow_first(page, shadow, span->x1, span->x2);
+		const int width = span->x2 - span->x1 + 1;
+
+		if (first < 0) {
+			panel->stats.unchanged += width;
+			span->x1 = PANEL_WIDTH;
+			span->x2 = -1;
+			continue;
+		}
+
+		const int last = panel_shadow_last(page, shadow, first, span->x2);
+
+		memcpy(&shadow[first], &page[first], last - first + 1);
+		panel->stats.unchanged += width - (last - first + 1);
+		span->x1 = first;
+		span->x2 = last;
+	}
+}
+#else
+static inline void panel_shadow_trim(struct panel_frame *frame)
+{
+	ARG_UNUSED(frame);
+}
+#endif /* CONFIG_APP_PANEL_SHADOW */
+
+/* Write every dirty page window of a frame to the display (blocking) */
+static void panel_send_frame(struct panel_frame *frame)
+{
+	struct panel *panel = frame->owner;
+	struct display_buffer_descriptor desc = {
+		.height = PANEL_PAGE_ROWS,
+	};
+	perf_ts_t start = perf_now();
+	uint32_t sent = 0;
+	bool written = false;
+
+	for (int p = 0; p < PANEL_PAGES; p++) {
+		const struct panel_span *span = &frame->dirty[p];
+
+		if (span->x1 > span->x2) {
+			continue;
+		}
+
+		written = true;
+
+		desc.width = span->x2 - span->x1 + 1;
+		desc.pitch = desc.width;
+		desc.buf_size = desc.width;
+
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+		int err = panel_bus_write_page(panel->bus, p, span->x1,
+					       &panel_frame_page(frame, p)[span->x1],
+					       desc.buf_size);
+#else
+		int err = display_write(panel->dev, span->x1,
+					p * PANEL_PAGE_ROWS, &desc,
+					&panel_frame_page(frame, p)[span->x1]);
+#endif
+		if (err) {
+			LOG_ERR("Page %d write failed: %d", p, err);
+			perf_add_bus_error();
+#ifdef CONFIG_APP_PANEL_SHADOW
+			/* Unknown what reached the panel: do not trim it */
+			atomic_set_bit(&panel->shadow_stale, p);
+#endif
+			continue;
+		}
+
+		panel->stats.pages++;
+		panel->stats.bytes += desc.buf_size;
+		sent += desc.buf_size;
+	}
+
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+	/* One CS assertion and one bus lock for the whole frame (if the
+	 * shadow left anything to send) */
+	if (written) {
+		panel_bus_end(panel->bus);
+	}
+#else
+	ARG_UNUSED(written);
+#endif
+
+	panel->stats.frames++;
+	if (sent > 0U) {
+		perf_add_bytes(sent);
+		perf_record(PERF_FLUSH, start);
+	}
+
+	if (frame->input) {
+		perf_input_frame_sent();
+	}
+}
+
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+/*
+ * Flush thread: sends frames in the order they were produced, whichever
+ * panel they belong to, and gives each back to its panel. The SPIM
+ * peripheral moves the bytes with EasyDMA; while display_write() waits for
+ * the transfer-complete interrupt, this thread sleeps and the CPU is free
+ * for LVGL to render the next frame.
+ */
+static void panel_flush_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct panel_frame *frame;
+
+	while (1) {
+		k_msgq_get(&panel_send_q, &frame, K_FOREVER);
+		panel_send_frame(frame);
+		k_msgq_put(&frame->owner->free_q, &frame, K_NO_WAIT);
+	}
+}
+
+K_THREAD_DEFINE(panel_flush_tid, CONFIG_APP_PANEL_FLUSH_STACK_SIZE,
+		panel_flush_thread, NULL, NULL, NULL,
+		CONFIG_APP_PANEL_FLUSH_THREAD_PRIORITY, 0, 0);
+#endif /* CONFIG_APP_PANEL_ASYNC_FLUSH */
+
+/* Get a frame to fill. Blocks only if both frames are still queued. */
+static struct panel_frame *panel_frame_get(struct panel *panel)
+{
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+	struct panel_frame *frame;
+
+	k_msgq_get(&panel->free_q, &frame, K_FOREVER);
+	return frame;
+#else
+	return &panel->frames[0];
+#endif
+}
+
+/* Hand what the first panel is about to receive to the UART mirror */
+static void panel_mirror(struct panel_frame *frame)
+{
+	if (!IS_ENABLED(CONFIG_APP_MIRROR) || frame->owner != &panels[0]) {
+		return;
+	}
+
+	mirror_frame_begin();
+	for (int p = 0; p < PANEL_PAGES; p++) {
+		const struct panel_span *span = &frame->dirty[p];
+
+		if (span->x1 <= span->x2) {
+			mirror_page(p, span->x1, span->x2,
+				    &panel_frame_page(frame, p)[span->x1],
+				    frame->owner->xor_mask);
+		}
+	}
+	mirror_frame_end();
+}
+
+/* Send a filled frame (queued for the flush thread, or right now) */
+static void panel_frame_put(struct panel_frame *frame)
+{
+	panel_shadow_trim(frame);
+	panel_mirror(frame);
+	frame->input = perf_input_frame_queued();
+
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+	k_msgq_put(&panel_send_q, &frame, K_FOREVER);
+#else
+	panel_send_frame(frame);
+#endif
+}
+
+/* Hand a finished LVGL frame to the display */
+static void panel_submit(struct panel *panel, const uint8_t *fb,
+			 uint32_t stride)
+{
+	struct panel_frame *frame = panel_frame_get(panel);
+
+	panel_fill_frame(frame, fb, stride);
+	panel_frame_put(frame);
+}
+
+#ifdef CONFIG_APP_PANEL_STRIP_RENDER
+/*
+ * Strip-render flush: 'px' holds just 'area' (page-aligned, see
+ * panel_round_cb). Its pages are converted and queued right away, so the
+ * strip is on the wire while LVGL renders the next one. A narrow area can
+ * be taller than one frame; it is then sent as several frames.
+ */
+static void panel_flush_strip(struct panel *panel, const lv_area_t *area,
+			      const uint8_t *px)
+{
+	const int32_t w = lv_area_get_width(area);
+	const uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_I1);
+	const int p1 = area->y1 / PANEL_PAGE_ROWS;
+	const int p2 = MIN(area->y2 / PANEL_PAGE_ROWS, panel->page_last);
+
+	for (int first = MAX(p1, panel->page_first); first <= p2;
+	     first += PANEL_FRAME_PAGES) {
+		struct panel_frame *frame = panel_frame_get(panel);
+		perf_ts_t start = perf_now();
+
+		panel_clear_spans(frame->dirty);
+		frame->page0 = first;
+
+		for (int p = first; p <= MIN(p2, first + PANEL_FRAME_PAGES - 1); p++) {
+			const uint8_t *rows = px + (p - p1) * PANEL_PAGE_ROWS * stride;
+
+			frame->dirty[p].x1 = area->x1;
+			frame->dirty[p].x2 = area->x2;
+			mono_transpose_page(rows, stride, 0, w - 1,
+					    &panel_frame_page(frame, p)[area->x1],
+					    panel->xor_mask);
+			page_image_blit(panel->disp, p, area->x1, area->x2,
+					panel_frame_page(frame, p), panel->xor_mask);
+			panel_apply_overlay(frame, p);
+		}
+
+		perf_record(PERF_TRANSPOSE, start);
+		panel_frame_put(frame);
+	}
+}
+
+/* Rounder: grow invalidated areas to whole pages and whole I1 bytes */
+static void panel_round_cb(lv_event_t *e)
+{
+	lv_area_t *area = lv_event_get_param(e);
+
+	area->x1 &= ~7;
+	area->x2 = MIN(area->x2 | 7, PANEL_WIDTH - 1);
+	area->y1 &= ~(PANEL_PAGE_ROWS - 1);
+	area->y2 = MIN(area->y2 | (PANEL_PAGE_ROWS - 1), PANEL_HEIGHT - 1);
+}
+#endif /* CONFIG_APP_PANEL_STRIP_RENDER */
+
+/*
+ * LVGL flush callback. In direct mode LVGL calls this once per redrawn area
+ * and always hands us the start of the full-frame buffer.
+ */
+static void panel_flush_cb(lv_display_t *disp, const lv_area_t *area,
+			   uint8_t *px_map)
+{
+	struct panel *panel = lv_display_get_driver_data(disp);
+
+#ifdef CONFIG_APP_PANEL_STRIP_RENDER
+	panel_flush_strip(panel, area, px_map + PANEL_I1_PALETTE_SIZE);
+#else
+	panel_mark_dirty(panel, area);
+
+	if (lv_display_flush_is_last(disp)) {
+		const uint32_t stride = lv_draw_buf_width_to_stride(PANEL_WIDTH,
+								    LV_COLOR_FORMAT_I1);
+
+		panel_submit(panel, px_map + PANEL_I1_PALETTE_SIZE, stride);
+	}
+#endif
+
+	/* The render buffer has been copied out: LVGL may draw into it again */
+	lv_display_flush_ready(disp);
+}
+
+/* Take over the flush path of 'disp', which drives 'dev' */
+static int panel_attach(lv_display_t *disp, const struct device *dev)
+{
+	struct display_capabilities caps;
+	struct panel *panel;
+
+	if (!device_is_ready(dev)) {
+		return -ENODEV;
+	}
+
+	display_get_capabilities(dev, &caps);
+	if ((caps.screen_info & SCREEN_INFO_MONO_VTILED) == 0U) {
+		LOG_ERR("%s is not page (VTILED) organized", dev->name);
+		return -ENOTSUP;
+	}
+
+	if (panel_count == PANEL_COUNT) {
+		return -ENOMEM;
+	}
+
+	panel = &panels[panel_count];
+	panel->disp = disp;
+	panel->dev = dev;
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+	panel->bus = &panel_buses[panel_count];
+	if (!spi_is_ready_dt(&panel->bus->spi)) {
+		return -ENODEV;
+	}
+
+	/* Before the first frame: the test pattern must not reach the panel */
+	uint32_t hz = spi_tune(&panel->bus->spi);
+
+	if (panel_count == 0) {
+		perf_set_bus_hz(hz);
+	}
+#endif
+	panel_count++;
+	panel->page_first = 0;
+	panel->page_last = PANEL_PAGES - 1;
+	panel->contrast = -1;
+#ifdef CONFIG_APP_PANEL_SHADOW
+	/* The display RAM holds garbage from before reset */
+	atomic_set(&panel->shadow_stale, BIT_MASK(PANEL_PAGES));
+#endif
+	panel->xor_mask = (caps.current_pixel_format == PIXEL_FORMAT_MONO10) ?
+			  0xFF : 0x00;
+	panel_clear_spans(panel->dirty);
+
+	for (int i = 0; i < PANEL_NUM_FRAMES; i++) {
+		panel->frames[i].owner = panel;
+	}
+
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+	k_msgq_init(&panel->free_q, (char *)panel->free_q_buf,
+		    sizeof(struct panel_frame *), PANEL_NUM_FRAMES);
+	for (int i = 0; i < PANEL_NUM_FRAMES; i++) {
+		struct panel_frame *frame = &panel->frames[i];
+
+		k_msgq_put(&panel->free_q, &frame, K_NO_WAIT);
+	}
+#endif
+
+	lv_display_set_driver_data(disp, panel);
+#ifdef CONFIG_APP_PANEL_STRIP_RENDER
+	/* Strips of whole pages, rendered into this panel's small buffer */
+	lv_display_set_buffers(disp, panel->vdb, NULL, sizeof(panel->vdb),
+			       LV_DISPLAY_RENDER_MODE_PARTIAL);
+	lv_display_add_event_cb(disp, panel_round_cb, LV_EVENT_INVALIDATE_AREA,
+				NULL);
+#else
+	/* Direct mode keeps the whole frame valid in the render buffer, so any
+	 * page can be re-read when only part of it was redrawn. This relies on
+	 * CONFIG_LV_Z_VDB_SIZE=100 (a full-frame buffer). */
+	lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+#endif
+	lv_display_set_flush_cb(disp, panel_flush_cb);
+
+	/* The panel may contain garbage from before reset: resend everything */
+	lv_obj_invalidate(lv_display_get_screen_active(disp));
+	return 0;
+}
+
+int panel_init(const struct device *display_dev)
+{
+	lv_display_t *disp = lv_display_get_default();
+	int err;
+
+	if (disp == NULL) {
+		LOG_ERR("LVGL display not initialized");
+		return -ENODEV;
+	}
+
+#if PANEL_GEOM_FIXED && !defined(CONFIG_APP_PANEL_STRIP_RENDER)
+	/* The specialized path hard-codes LVGL's frame row stride */
+	if (lv_draw_buf_width_to_stride(PANEL_WIDTH, LV_COLOR_FORMAT_I1) !=
+	    PANEL_FB_STRIDE) {
+		LOG_ERR("Unexpected I1 stride, disable CONFIG_APP_PANEL_FIXED_GEOMETRY");
+		return -ENOTSUP;
+	}
+#endif
+
+	err = panel_attach(disp, display_dev);
+	if (err) {
+		return err;
+	}
+
+	mono_transpose_bench(PANEL_WIDTH, PANEL_HEIGHT);
+
+	LOG_INF("Dirty-page flush: %dx%d, %d pages per frame, %s, %s path, %s",
+		PANEL_WIDTH, PANEL_HEIGHT, PANEL_FRAME_PAGES,
+		IS_ENABLED(CONFIG_APP_PANEL_ASYNC_FLUSH) ? "async" : "sync",
+		PANEL_GEOM_FIXED ? "fixed-geometry" : "generic",
+		IS_ENABLED(CONFIG_APP_PANEL_SPI_BATCH) ? "batched SPI" :
+							 "display_write");
+	return 0;
+}
+
+#ifdef PANEL2_NODE
+BUILD_ASSERT(DT_PROP(PANEL2_NODE, width) == PANEL_WIDTH &&
+	     DT_PROP(PANEL2_NODE, height) == PANEL_HEIGHT,
+	     "Both panels must have the same geometry");
+
+#ifndef CONFIG_APP_PANEL_STRIP_RENDER
+/* Render buffer of the second display: palette + one full I1 frame */
+static uint8_t panel2_vdb[PANEL_I1_PALETTE_SIZE +
+			  PANEL_FB_STRIDE * PANEL_HEIGHT] __aligned(LV_DRAW_BUF_ALIGN);
+#endif
+
+lv_display_t *panel_init_second(void)
+{
+	const struct device *dev = DEVICE_DT_GET(PANEL2_NODE);
+	lv_display_t *disp;
+	int err;
+
+	if (!device_is_ready(dev)) {
+		LOG_ERR("Second display not ready");
+		return NULL;
+	}
+
+	/* Zephyr's LVGL glue only creates the zephyr,display one */
+	disp = lv_display_create(PANEL_WIDTH, PANEL_HEIGHT);
+	if (disp == NULL) {
+		return NULL;
+	}
+
+	lv_display_set_color_format(disp, LV_COLOR_FORMAT_I1);
+#ifndef CONFIG_APP_PANEL_STRIP_RENDER
+	/* (In strip mode panel_attach() gives it its strip buffer) */
+	lv_display_set_buffers(disp, panel2_vdb, NULL, sizeof(panel2_vdb),
+			       LV_DISPLAY_RENDER_MODE_DIRECT);
+#endif
+
+	err = panel_attach(disp, dev);
+	if (err) {
+		LOG_ERR("Second panel setup failed: %d", err);
+		lv_display_delete(disp);
+		return NULL;
+	}
+
+	display_blanking_off(dev);
+	LOG_INF("Second panel: %s", dev->name);
+	return disp;
+}
+#else
+lv_display_t *panel_init_second(void)
+{
+	return NULL;
+}
+#endif /* PANEL2_NODE */
+
+void panel_flush_wait(void)
+{
+#ifdef CONFIG_APP_PANEL_ASYNC_FLUSH
+	/* All frames are back in the free queues once the bus is idle */
+	for (int i = 0; i < panel_count; i++) {
+		while (k_msgq_num_used_get(&panels[i].free_q) < PANEL_NUM_FRAMES) {
+			k_sleep(K_MSEC(1));
+		}
+	}
+#endif
+}
+
+void panel_overlay_set(int page, int x1, int x2, const uint8_t *cols)
+{
+	struct panel *panel = &panels[0];
+
+	__ASSERT_NO_MSG(page >= 0 && page < PANEL_PAGES);
+	__ASSERT_NO_MSG(x1 >= 0 && x1 <= x2 && x2 < PANEL_WIDTH);
+
+	panel->overlay.cols = cols;
+	panel->overlay.page = page;
+	panel->overlay.x1 = x1;
+	panel->overlay.x2 = x2;
+
+	if (cols == NULL) {
+		/* Give the window back to LVGL */
+		lv_area_t area = {
+			.x1 = x1, .y1 = page * PANEL_PAGE_ROWS,
+			.x2 = x2, .y2 = page * PANEL_PAGE_ROWS + PANEL_PAGE_ROWS - 1,
+		};
+
+		lv_obj_invalidate_area(lv_display_get_screen_active(panel->disp),
+				       &area);
+		return;
+	}
+
+	/* A dark page: kept, and sent once the page is driven again */
+	if (page < panel->page_first || page > panel->page_last) {
+		return;
+	}
+
+	/* A frame holding nothing but the overlay window */
+	struct panel_frame *frame = panel_frame_get(panel);
+
+	panel_clear_spans(frame->dirty);
+	frame->page0 = MIN(page, PANEL_PAGES - PANEL_FRAME_PAGES);
+	frame->dirty[page].x1 = x1;
+	frame->dirty[page].x2 = x2;
+	panel_apply_overlay(frame, page);
+	panel_frame_put(frame);
+}
+
+void panel_get_stats(struct panel_stats *stats)
+{
+	*stats = (struct panel_stats){ 0 };
+
+	for (int i = 0; i < panel_count; i++) {
+		stats->frames += panels[i].stats.frames;
+		stats->pages += panels[i].stats.pages;
+		stats->bytes += panels[i].stats.bytes;
+		stats->unchanged += panels[i].stats.unchanged;
+	}
+}
+
+int panel_set_active_pages(int first, int count)
+{
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+	struct panel *panel = &panels[0];
+	const int last = first + count - 1;
+	int err;
+
+	/* Multiplex ratios below 16 rows are invalid on the controller */
+	if (first < 0 || count < 2 || last >= PANEL_PAGES) {
+		return -EINVAL;
+	}
+
+	/* The commands share the frames' locked SPI config (panel_bus.h) */
+	panel_flush_wait();
+	err = panel_bus_set_rows(panel->bus, first * PANEL_PAGE_ROWS,
+				 count * PANEL_PAGE_ROWS);
+	if (err) {
+		perf_add_bus_error();
+		return err;
+	}
+
+	/* Pages that come back were not sent while dark: redraw them all */
+	const bool grown = first < panel->page_first || last > panel->page_last;
+
+	panel->page_first = first;
+	panel->page_last = last;
+	if (grown) {
+		lv_obj_invalidate(lv_display_get_screen_active(panel->disp));
+	}
+
+	LOG_INF("Active pages %d-%d", first, last);
+	return 0;
+#else
+	ARG_UNUSED(first);
+	ARG_UNUSED(count);
+	return -ENOTSUP;
+#endif
+}
+
+int panel_set_drive(uint8_t contrast, uint8_t precharge)
+{
+#ifdef CONFIG_APP_PANEL_SPI_BATCH
+	struct panel *panel = &panels[0];
+	int err;
+
+	panel_flush_wait();
+	err = display_set_contrast(panel->dev, contrast);
+	if (err == 0) {
+		err = panel_bus_set_precharge(panel->bus, precharge);
+	}
+	if (err) {
+		perf_add_bus_error();
+		return err;
+	}
+
+	panel->contrast = contrast;
+	return 0;
+#else
+	ARG_UNUSED(contrast);
+	ARG_UNUSED(precharge);
+	return -ENOTSUP;
+#endif
+}
+
+int panel_get_contrast(void)
+{
+	return panels[0].contrast;
+}
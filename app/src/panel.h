@@ -0,0 +1,111 @@
+/*
+ * =============================================================================
+ * SH1106 panel flush engine
+ * =============================================================================
+ * Replaces the generic LVGL -> Zephyr display flush with one that knows how
+ * the SH1106/SSD1306 controller stores pixels: in "pages" of 8 rows, where
+ * one byte holds 8 vertical pixels of one column.
+ *
+ * Instead of pushing the whole 128x64 frame on every LVGL refresh, the panel
+ * module remembers which columns of which pages were touched and only sends
+ * those page/column windows over SPI.
+ *
+ * A second SH1106 on the same bus (dual_panel.overlay) gets its own LVGL
+ * display and frame buffers. Both share the one flush thread, which sends
+ * finished frames in order, so one panel is rendered while the other one's
+ * frame is on the wire.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_PANEL_H_
+#define APP_PANEL_H_
+
+#include <zephyr/device.h>
+#include <lvgl.h>
+#include <stdint.h>
+
+#include "panel_geom.h"
+
+/*
+ * Take over the flush path of the default LVGL display.
+ *
+ * Must be called once after LVGL has been initialized (CONFIG_LV_Z_AUTO_INIT
+ * does that before main()) and before the first lv_task_handler() call.
+ *
+ * Returns 0 on success or a negative errno code.
+ */
+int panel_init(const struct device *display_dev);
+
+/*
+ * Create an LVGL display for the second panel (the "display1" devicetree
+ * alias) and take over its flush path. Call after panel_init().
+ *
+ * Returns the new display, or NULL if the board has no second panel or it
+ * could not be set up.
+ */
+lv_display_t *panel_init_second(void);
+
+/*
+ * Block until every queued frame has been written to the display.
+ * Returns immediately when CONFIG_APP_PANEL_ASYNC_FLUSH is disabled.
+ */
+void panel_flush_wait(void);
+
+/*
+ * Overlay: show 'cols' in columns [x1, x2] of page 'page' instead of what
+ * LVGL rendered there. cols[0] is column x1; bytes are in controller format
+ * (LSB = top row, 1 = pixel lit) and must stay valid while the overlay is
+ * set. Each call sends the window right away, without involving LVGL, so
+ * moving content (a marquee) costs one page window per step. Pass
+ * cols = NULL to remove the overlay and let LVGL redraw the window.
+ *
+ * Only one overlay exists at a time, on the first panel. Call from the
+ * thread that owns LVGL.
+ */
+void panel_overlay_set(int page, int x1, int x2, const uint8_t *cols);
+
+/*
+ * Partial display: drive only pages [first, first + count) of the first
+ * panel (multiplex ratio, display offset and start line). The other rows
+ * go dark, which lowers the panel current, and their pages are no longer
+ * converted or sent. Content keeps its position. Growing the range again
+ * redraws the screen, since the pages that come back were not kept up to
+ * date. panel_set_active_pages(0, PANEL_PAGES) restores the full screen.
+ *
+ * Returns 0, -EINVAL for a bad range (count must be at least 2: the
+ * controller drives no fewer than 16 rows), -ENOTSUP without
+ * CONFIG_APP_PANEL_SPI_BATCH, or the SPI error. Call from the thread that
+ * owns LVGL, while the bus is not idle (see idle.h).
+ */
+int panel_set_active_pages(int first, int count);
+
+/*
+ * Set contrast (0-255) and precharge periods (0xD9 byte: phase 2 in the
+ * high nibble, phase 1 in the low one; the devicetree prechargep is the
+ * boot value) of the first panel, e.g. to follow ambient light. Longer
+ * precharge and higher contrast look brighter and draw more current. The
+ * idle mode dims from, and restores, this contrast.
+ *
+ * Same return values and calling rules as panel_set_active_pages().
+ */
+int panel_set_drive(uint8_t contrast, uint8_t precharge);
+
+/* Contrast last set with panel_set_drive(), or -1 if never set */
+int panel_get_contrast(void);
+
+/*
+ * Flush statistics (all panels together), mostly useful to check how much
+ * SPI traffic we save.
+ */
+struct panel_stats {
+	uint32_t frames;      /* Number of completed LVGL refresh cycles */
+	uint32_t pages;       /* Number of page windows sent to the display */
+	uint32_t bytes;       /* Number of pixel bytes sent to the display */
+	uint32_t unchanged;   /* Dirty bytes not sent: the panel showed them */
+};
+
+void panel_get_stats(struct panel_stats *stats);
+
+#endif /* APP_PANEL_H_ */
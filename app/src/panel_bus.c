@@ -0,0 +1,109 @@
+/*
+ * =============================================================================
+ * Batched SPI writes of SH1106 page windows
+ * =============================================================================
+ * SH1106 addressing, as used by the Zephyr driver: 0xB0 | page selects the
+ * page, 0x00 | low nibble and 0x10 | high nibble set the column. Data bytes
+ * then fill consecutive columns of that page.
+ *
+ * nRF52832's SPIM has no hardware DC (DCX) output, so the pin is still
+ * switched by software between the command and data parts. What goes away
+ * is the per-transaction driver overhead and chip-select toggling.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/kernel.h>
+
+#include "panel_bus.h"
+
+#define SH1106_SET_PAGE      0xB0
+#define SH1106_SET_COL_LOW   0x00
+#define SH1106_SET_COL_HIGH  0x10
+#define SH1106_SET_START_LINE 0x40
+#define SH1106_SET_MULTIPLEX 0xA8
+#define SH1106_SET_OFFSET    0xD3
+#define SH1106_SET_PRECHARGE 0xD9
+
+/* COM lines of the controller: the display offset counts modulo this */
+#define SH1106_COM_COUNT     64
+
+static int panel_bus_send(const struct panel_bus *bus, const void *buf,
+			  size_t len)
+{
+	const struct spi_buf sbuf = { .buf = (void *)buf, .len = len };
+	const struct spi_buf_set set = { .buffers = &sbuf, .count = 1 };
+
+	return spi_write_dt(&bus->spi, &set);
+}
+
+int panel_bus_write_page(const struct panel_bus *bus, int page, int x,
+			 const uint8_t *data, size_t len)
+{
+	const int col = x + bus->col_offset;
+	const uint8_t cmd[] = {
+		SH1106_SET_PAGE | (page + bus->page_offset),
+		SH1106_SET_COL_LOW | (col & 0x0F),
+		SH1106_SET_COL_HIGH | (col >> 4),
+	};
+	int err;
+
+	gpio_pin_set_dt(&bus->dc, 0);
+	err = panel_bus_send(bus, cmd, sizeof(cmd));
+	if (err) {
+		return err;
+	}
+
+	gpio_pin_set_dt(&bus->dc, 1);
+	return panel_bus_send(bus, data, len);
+}
+
+void panel_bus_end(const struct panel_bus *bus)
+{
+	spi_release_dt(&bus->spi);
+}
+
+static int panel_bus_command(const struct panel_bus *bus, const uint8_t *cmd,
+			     size_t len)
+{
+	int err;
+
+	gpio_pin_set_dt(&bus->dc, 0);
+	err = panel_bus_send(bus, cmd, len);
+	panel_bus_end(bus);
+	return err;
+}
+
+int panel_bus_set_rows(const struct panel_bus *bus, int row0, int rows)
+{
+	/*
+	 * Row counter r = 0..rows-1 shows RAM row (start line + r) on COM
+	 * (r - offset). Start line row0 and offset -row0 put RAM row row0 + r
+	 * back on COM row0 + r, on top of the devicetree display-offset.
+	 *
+	 * With com-invdir the counter runs down from COM (rows - 1) instead,
+	 * and the screen's row y is COM (63 - y): the same rows need the
+	 * offset 64 - rows - row0 to stay in place.
+	 */
+	const int offset = bus->com_invdir ?
+			   2 * SH1106_COM_COUNT - rows - row0 :
+			   SH1106_COM_COUNT - row0;
+	const uint8_t cmd[] = {
+		SH1106_SET_MULTIPLEX, rows - 1,
+		SH1106_SET_OFFSET,
+		(bus->com_offset + offset) % SH1106_COM_COUNT,
+		SH1106_SET_START_LINE | row0,
+	};
+
+	return panel_bus_command(bus, cmd, sizeof(cmd));
+}
+
+int panel_bus_set_precharge(const struct panel_bus *bus, uint8_t precharge)
+{
+	const uint8_t cmd[] = { SH1106_SET_PRECHARGE, precharge };
+
+	return panel_bus_command(bus, cmd, sizeof(cmd));
+}
@@ -0,0 +1,79 @@
+/*
+ * =============================================================================
+ * Batched SPI writes of SH1106 page windows
+ * =============================================================================
+ * Going through display_write(), every page window costs two separate SPI
+ * transactions (the 3 addressing commands with DC low, then the data with DC
+ * high). Each one takes the bus lock, re-applies the SPI configuration and
+ * toggles chip select.
+ *
+ * This path writes the windows of a whole frame inside one locked
+ * transaction: the bus is locked and CS asserted once at the start
+ * (SPI_LOCK_ON | SPI_HOLD_ON_CS), and in between only the DC pin changes.
+ * The display driver still initializes the controller and handles contrast
+ * and blanking; those calls wait for the bus while a frame is being sent.
+ *
+ * It also sends the few controller commands the driver has no API for
+ * (active COM rows, precharge). Those use the same locked SPI config as the
+ * frames, so they must not be sent while a frame is in flight: call
+ * panel_flush_wait() first.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_PANEL_BUS_H_
+#define APP_PANEL_BUS_H_
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/spi.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct panel_bus {
+	struct spi_dt_spec spi;
+	struct gpio_dt_spec dc;      /* Data/command pin, 1 = data */
+	uint8_t col_offset;          /* devicetree segment-offset */
+	uint8_t page_offset;         /* devicetree page-offset */
+	uint8_t com_offset;          /* devicetree display-offset */
+	bool com_invdir;             /* devicetree com-invdir (COM scan reversed) */
+};
+
+#define PANEL_BUS_SPI_OP                                                     \
+	(SPI_OP_MODE_MASTER | SPI_WORD_SET(8) | SPI_TRANSFER_MSB |            \
+	 SPI_HOLD_ON_CS | SPI_LOCK_ON)
+
+/* Bus description of an SH1106 devicetree node */
+#define PANEL_BUS_DT_SPEC_GET(node)                                          \
+	{                                                                     \
+		.spi = SPI_DT_SPEC_GET(node, PANEL_BUS_SPI_OP, 0),            \
+		.dc = GPIO_DT_SPEC_GET(node, data_cmd_gpios),                 \
+		.col_offset = DT_PROP_OR(node, segment_offset, 0),            \
+		.page_offset = DT_PROP_OR(node, page_offset, 0),              \
+		.com_offset = DT_PROP_OR(node, display_offset, 0),            \
+		.com_invdir = DT_PROP(node, com_invdir),                      \
+	}
+
+/* Write 'len' bytes at column 'x' of page 'page' (visible coordinates).
+ * The bus stays locked with CS asserted until panel_bus_end(). */
+int panel_bus_write_page(const struct panel_bus *bus, int page, int x,
+			 const uint8_t *data, size_t len);
+
+/* Deassert CS and unlock the bus after the last window of a frame */
+void panel_bus_end(const struct panel_bus *bus);
+
+/*
+ * Drive only the screen rows [row0, row0 + rows): multiplex ratio, display
+ * offset and start line are set so those rows stay where they were and the
+ * others go dark. row0 = 0 with the full height restores the devicetree
+ * setup. rows must be at least 16 (the smallest multiplex ratio). Ends the
+ * transaction like panel_bus_end().
+ */
+int panel_bus_set_rows(const struct panel_bus *bus, int row0, int rows);
+
+/* Precharge periods (0xD9): phase 2 in the high nibble, phase 1 in the low */
+int panel_bus_set_precharge(const struct panel_bus *bus, uint8_t precharge);
+
+#endif /* APP_PANEL_BUS_H_ */
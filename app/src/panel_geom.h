@@ -0,0 +1,57 @@
+/*
+ * =============================================================================
+ * Panel geometry, fixed at compile time from the devicetree
+ * =============================================================================
+ * Everything here comes from the "zephyr,display" node of the board
+ * overlay, so loop bounds, page counts and row strides are compile-time
+ * constants the compiler can fold. (The segment-offset and page-offset
+ * properties are added to every window by the display driver itself.)
+ *
+ * PANEL_GEOM_FIXED says whether the panel module may use the specialized
+ * path for this geometry (frame stride known at build time, whole 8-column
+ * blocks). Panels that don't fit it use the generic runtime path.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_PANEL_GEOM_H_
+#define APP_PANEL_GEOM_H_
+
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+
+/* Number of pixel rows stored in one controller page (one byte per column) */
+#define PANEL_PAGE_ROWS 8
+
+#define PANEL_NODE   DT_CHOSEN(zephyr_display)
+#define PANEL_WIDTH  DT_PROP(PANEL_NODE, width)
+#define PANEL_HEIGHT DT_PROP(PANEL_NODE, height)
+#define PANEL_PAGES  (PANEL_HEIGHT / PANEL_PAGE_ROWS)
+
+/*
+ * Optional second panel on the same SPI bus: the "display1" alias (see
+ * dual_panel.overlay). It must have the same geometry as the first one.
+ */
+#if DT_NODE_HAS_STATUS(DT_ALIAS(display1), okay)
+#define PANEL2_NODE  DT_ALIAS(display1)
+#define PANEL_COUNT  2
+#else
+#define PANEL_COUNT  1
+#endif
+
+/* Bytes per row of LVGL's I1 frame buffer, if no row padding is needed */
+#define PANEL_FB_STRIDE      (PANEL_WIDTH / 8)
+
+/* 8-column blocks in one page row */
+#define PANEL_BLOCKS         (PANEL_WIDTH / 8)
+
+#if defined(CONFIG_APP_PANEL_FIXED_GEOMETRY) && ((PANEL_WIDTH % 8) == 0) && \
+	(!defined(LV_DRAW_BUF_STRIDE_ALIGN) || (LV_DRAW_BUF_STRIDE_ALIGN == 1))
+#define PANEL_GEOM_FIXED 1
+#else
+#define PANEL_GEOM_FIXED 0
+#endif
+
+#endif /* APP_PANEL_GEOM_H_ */
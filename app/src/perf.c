@@ -0,0 +1,471 @@
+/*
+ * =============================================================================
+ * Frame timing and SPI throughput instrumentation
+ * =============================================================================
+ * Samples arrive from two threads (LVGL: render and transpose; flush thread:
+ * flush and bytes), so updates and snapshots are done under a spinlock.
+ * Recording a sample is a handful of additions and one bucket increment.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+#include <string.h>
+
+#include "perf.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(perf, LOG_LEVEL_INF);
+
+static const char *const perf_metric_names[PERF_METRIC_COUNT] = {
+	[PERF_RENDER] = "render",
+	[PERF_TRANSPOSE] = "transpose",
+	[PERF_FLUSH] = "flush",
+	[PERF_FRAME] = "frame",
+	[PERF_INPUT] = "input",
+};
+
+struct perf_stat {
+	uint32_t count;
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t sum_us;
+	uint64_t sum_sq_us;       /* For the standard deviation */
+	uint32_t hist[PERF_HIST_BUCKETS];
+};
+
+struct perf_screen {
+	const char *name;
+	struct perf_stat stat[PERF_METRIC_COUNT];
+	uint64_t bytes;
+};
+
+static struct perf_screen perf_screens[CONFIG_APP_PERF_MAX_SCREENS];
+static struct perf_screen *perf_current = &perf_screens[0];
+static struct k_spinlock perf_lock;
+
+/* Panel bus: SPI clock and failed transfers since boot (not reset) */
+static atomic_t perf_bus_hz;
+static atomic_t perf_bus_errors;
+
+/* Render bracket state (only touched from the LVGL thread) */
+static perf_ts_t perf_render_start;
+static bool perf_frame_seen;
+/* End of the last rendered frame, for PERF_FRAME */
+static perf_ts_t perf_frame_end;
+static bool perf_frame_end_valid;
+
+/* Input latency. 'left' counts the tagged frames not sent yet, plus one
+ * while the render run is still going; whoever takes it to zero records. */
+static atomic_t perf_input_pending;
+static perf_ts_t perf_input_isr;
+static perf_ts_t perf_input_start;
+static perf_ts_t perf_input_sent_at;
+static atomic_t perf_input_left;
+static bool perf_input_open;
+static uint32_t perf_input_frames;
+
+static void perf_stat_clear(struct perf_stat *st)
+{
+	memset(st, 0, sizeof(*st));
+	st->min_us = UINT32_MAX;
+}
+
+static void perf_stat_add(struct perf_stat *st, uint32_t us)
+{
+	/* Bucket = position of the highest set bit, 0 for 0 and 1 us */
+	uint32_t bucket = (us > 1U) ? (31U - __builtin_clz(us)) : 0U;
+
+	st->count++;
+	st->sum_us += us;
+	st->sum_sq_us += (uint64_t)us * us;
+	st->min_us = MIN(st->min_us, us);
+	st->max_us = MAX(st->max_us, us);
+	st->hist[MIN(bucket, PERF_HIST_BUCKETS - 1)]++;
+}
+
+void perf_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(perf_screens); i++) {
+		for (int m = 0; m < PERF_METRIC_COUNT; m++) {
+			perf_stat_clear(&perf_screens[i].stat[m]);
+		}
+		perf_screens[i].bytes = 0;
+	}
+
+	/* The next frame time starts from the next frame */
+	perf_frame_end_valid = false;
+
+	k_spin_unlock(&perf_lock, key);
+}
+
+void perf_set_screen(const char *name)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_lock);
+	struct perf_screen *free_slot = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(perf_screens); i++) {
+		if (perf_screens[i].name == name) {
+			perf_current = &perf_screens[i];
+			goto out;
+		}
+		if (perf_screens[i].name == NULL && free_slot == NULL) {
+			free_slot = &perf_screens[i];
+		}
+	}
+
+	/* New screen; when the table is full, keep counting into the last one */
+	if (free_slot != NULL) {
+		free_slot->name = name;
+		perf_current = free_slot;
+	}
+
+out:
+	k_spin_unlock(&perf_lock, key);
+}
+
+void perf_set_bus_hz(uint32_t hz)
+{
+	atomic_set(&perf_bus_hz, hz);
+}
+
+void perf_add_bus_error(void)
+{
+	atomic_inc(&perf_bus_errors);
+}
+
+static void perf_record_span(enum perf_metric metric, perf_ts_t start,
+			     perf_ts_t end)
+{
+	uint32_t us = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) /
+				 NSEC_PER_USEC);
+	k_spinlock_key_t key = k_spin_lock(&perf_lock);
+
+	perf_stat_add(&perf_current->stat[metric], us);
+
+	k_spin_unlock(&perf_lock, key);
+}
+
+void perf_record(enum perf_metric metric, perf_ts_t start)
+{
+	perf_record_span(metric, start, timing_counter_get());
+
+	if (metric == PERF_TRANSPOSE) {
+		perf_frame_seen = true;
+	}
+}
+
+void perf_add_bytes(uint32_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_lock);
+
+	perf_current->bytes += bytes;
+
+	k_spin_unlock(&perf_lock, key);
+}
+
+void perf_render_begin(void)
+{
+	perf_frame_seen = false;
+	perf_render_start = timing_counter_get();
+}
+
+void perf_render_end(void)
+{
+	if (!perf_frame_seen) {
+		return;
+	}
+
+	perf_record(PERF_RENDER, perf_render_start);
+
+	if (perf_frame_end_valid) {
+		perf_record(PERF_FRAME, perf_frame_end);
+	}
+	perf_frame_end = timing_counter_get();
+	perf_frame_end_valid = true;
+}
+
+void perf_input_event(void)
+{
+	/* Keep the first press not yet picked up by a render run */
+	if (!atomic_test_and_set_bit(&perf_input_pending, 0)) {
+		perf_input_isr = timing_counter_get();
+	}
+}
+
+void perf_input_run_begin(void)
+{
+	const bool pressed = atomic_test_and_clear_bit(&perf_input_pending, 0);
+
+	/* A press while the previous one is still on the wire is not measured */
+	if (!pressed || atomic_get(&perf_input_left) != 0) {
+		return;
+	}
+
+	perf_input_start = perf_input_isr;
+	perf_input_frames = 0;
+	perf_input_open = true;
+	atomic_set(&perf_input_left, 1);
+}
+
+bool perf_input_frame_queued(void)
+{
+	if (!perf_input_open) {
+		return false;
+	}
+
+	perf_input_frames++;
+	atomic_inc(&perf_input_left);
+	return true;
+}
+
+void perf_input_frame_sent(void)
+{
+	perf_input_sent_at = timing_counter_get();
+
+	if (atomic_dec(&perf_input_left) == 1) {
+		perf_record_span(PERF_INPUT, perf_input_start, perf_input_sent_at);
+	}
+}
+
+void perf_input_run_end(void)
+{
+	if (!perf_input_open) {
+		return;
+	}
+	perf_input_open = false;
+
+	/* Every frame is out already: the last one ended the sample. A press
+	 * that changed nothing on screen gives no sample. */
+	if (atomic_dec(&perf_input_left) == 1 && perf_input_frames > 0U) {
+		perf_record_span(PERF_INPUT, perf_input_start, perf_input_sent_at);
+	}
+}
+
+/* Integer square root (rounded down) */
+static uint32_t perf_isqrt(uint64_t v)
+{
+	uint64_t r = 0;
+
+	for (uint64_t bit = 1ULL << 62; bit != 0U; bit >>= 2) {
+		if (v >= r + bit) {
+			v -= r + bit;
+			r = (r >> 1) + bit;
+		} else {
+			r >>= 1;
+		}
+	}
+
+	return (uint32_t)r;
+}
+
+static uint32_t perf_stat_sd(const struct perf_stat *st)
+{
+	if (st->count < 2U) {
+		return 0U;
+	}
+
+	/* E[x^2] - E[x]^2, in us^2 */
+	const uint64_t mean = st->sum_us / st->count;
+	const uint64_t mean_sq = st->sum_sq_us / st->count;
+
+	return perf_isqrt(mean_sq > mean * mean ? mean_sq - mean * mean : 0U);
+}
+
+static void perf_snapshot(struct perf_screen *snap)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_lock);
+
+	memcpy(snap, perf_screens, sizeof(perf_screens));
+
+	k_spin_unlock(&perf_lock, key);
+}
+
+int perf_get_summary(const char *name, struct perf_summary *sum)
+{
+	k_spinlock_key_t key = k_spin_lock(&perf_lock);
+	int ret = -ENOENT;
+
+	for (int i = 0; i < ARRAY_SIZE(perf_screens); i++) {
+		const struct perf_screen *ps = &perf_screens[i];
+
+		if (ps->name == NULL || ps->name != name) {
+			continue;
+		}
+
+		sum->bytes = ps->bytes;
+		for (int m = 0; m < PERF_METRIC_COUNT; m++) {
+			const struct perf_stat *st = &ps->stat[m];
+
+			sum->metric[m].count = st->count;
+			sum->metric[m].avg_us = st->count ? st->sum_us / st->count : 0U;
+			sum->metric[m].min_us = st->count ? st->min_us : 0U;
+			sum->metric[m].max_us = st->max_us;
+			sum->metric[m].sd_us = perf_stat_sd(st);
+		}
+		ret = 0;
+		break;
+	}
+
+	k_spin_unlock(&perf_lock, key);
+	return ret;
+}
+
+/* Output sink for perf_print(): the log or a shell */
+typedef void (*perf_print_fn)(void *ctx, const char *line);
+
+/* Format the summary of every screen, one line at a time */
+static void perf_print(const struct perf_screen *snap, perf_print_fn print,
+		       void *ctx)
+{
+	char line[80];
+
+	snprintk(line, sizeof(line), "bus: %u Hz, %u failed transfers",
+		 (uint32_t)atomic_get(&perf_bus_hz),
+		 (uint32_t)atomic_get(&perf_bus_errors));
+	print(ctx, line);
+
+	for (int i = 0; i < CONFIG_APP_PERF_MAX_SCREENS; i++) {
+		const struct perf_screen *ps = &snap[i];
+		const uint32_t frames = ps->stat[PERF_FLUSH].count;
+
+		if (ps->name == NULL) {
+			continue;
+		}
+
+		snprintk(line, sizeof(line), "%s: %llu bytes, %llu bytes/frame",
+			 ps->name, ps->bytes,
+			 frames ? ps->bytes / frames : 0ULL);
+		print(ctx, line);
+
+		for (int m = 0; m < PERF_METRIC_COUNT; m++) {
+			const struct perf_stat *st = &ps->stat[m];
+
+			if (st->count == 0U) {
+				continue;
+			}
+
+			snprintk(line, sizeof(line),
+				 "  %-9s n=%u avg=%llu min=%u max=%u sd=%u us",
+				 perf_metric_names[m], st->count,
+				 st->sum_us / st->count, st->min_us, st->max_us,
+				 perf_stat_sd(st));
+			print(ctx, line);
+		}
+	}
+}
+
+static void perf_print_log(void *ctx, const char *line)
+{
+	ARG_UNUSED(ctx);
+
+	LOG_INF("%s", line);
+}
+
+void perf_log_summary(void)
+{
+	static struct perf_screen snap[CONFIG_APP_PERF_MAX_SCREENS];
+
+	perf_snapshot(snap);
+	perf_print(snap, perf_print_log, NULL);
+}
+
+#if CONFIG_APP_PERF_LOG_INTERVAL_MS > 0
+/* Each periodic summary covers one interval: statistics restart after it */
+static void perf_log_work_handler(struct k_work *work)
+{
+	perf_log_summary();
+	perf_reset();
+	k_work_reschedule(k_work_delayable_from_work(work),
+			  K_MSEC(CONFIG_APP_PERF_LOG_INTERVAL_MS));
+}
+
+static K_WORK_DELAYABLE_DEFINE(perf_log_work, perf_log_work_handler);
+#endif
+
+void perf_init(void)
+{
+	timing_init();
+	timing_start();
+	perf_reset();
+
+#if CONFIG_APP_PERF_LOG_INTERVAL_MS > 0
+	k_work_schedule(&perf_log_work, K_MSEC(CONFIG_APP_PERF_LOG_INTERVAL_MS));
+#endif
+}
+
+#ifdef CONFIG_APP_PERF_SHELL
+static void perf_print_shell(void *ctx, const char *line)
+{
+	shell_print((const struct shell *)ctx, "%s", line);
+}
+
+static int cmd_perf_show(const struct shell *sh, size_t argc, char **argv)
+{
+	static struct perf_screen snap[CONFIG_APP_PERF_MAX_SCREENS];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	perf_snapshot(snap);
+	perf_print(snap, perf_print_shell, (void *)sh);
+	return 0;
+}
+
+static int cmd_perf_hist(const struct shell *sh, size_t argc, char **argv)
+{
+	static struct perf_screen snap[CONFIG_APP_PERF_MAX_SCREENS];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	perf_snapshot(snap);
+	shell_print(sh, "bucket i = [2^i, 2^(i+1)) us");
+
+	for (int i = 0; i < ARRAY_SIZE(snap); i++) {
+		if (snap[i].name == NULL) {
+			continue;
+		}
+		for (int m = 0; m < PERF_METRIC_COUNT; m++) {
+			const struct perf_stat *st = &snap[i].stat[m];
+
+			if (st->count == 0U) {
+				continue;
+			}
+			shell_fprintf(sh, SHELL_NORMAL, "%s/%s:", snap[i].name,
+				      perf_metric_names[m]);
+			for (int b = 0; b < PERF_HIST_BUCKETS; b++) {
+				shell_fprintf(sh, SHELL_NORMAL, " %u", st->hist[b]);
+			}
+			shell_fprintf(sh, SHELL_NORMAL, "\n");
+		}
+	}
+	return 0;
+}
+
+static int cmd_perf_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	perf_reset();
+	shell_print(sh, "perf statistics cleared");
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(perf_cmds,
+	SHELL_CMD(show, NULL, "Per-screen frame timing summary", cmd_perf_show),
+	SHELL_CMD(hist, NULL, "Per-screen timing histograms", cmd_perf_hist),
+	SHELL_CMD(reset, NULL, "Clear all statistics", cmd_perf_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(perf, &perf_cmds, "Frame timing instrumentation", NULL);
+#endif /* CONFIG_APP_PERF_SHELL */
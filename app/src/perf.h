@@ -0,0 +1,150 @@
+/*
+ * =============================================================================
+ * Frame timing and SPI throughput instrumentation
+ * =============================================================================
+ * Measures, per demo screen:
+ *   - render:    time LVGL spends in lv_timer_handler() for a frame
+ *   - transpose: time to convert the dirty pages into controller format
+ *   - flush:     time to write a frame to the panel (SPI on the wire)
+ *   - frame:     time from one rendered frame to the next; its standard
+ *                deviation is the frame-time jitter
+ *   - input:     time from a button interrupt (input.c) to the last SPI
+ *                byte of the frames rendered for it
+ *   - bytes:     pixel bytes sent over SPI
+ *
+ * For the whole system (not per screen) it also keeps the SPI clock the
+ * panel bus runs at (see spi_tune.c) and the number of failed transfers.
+ *
+ * Times come from the Zephyr timing API, which reads the DWT cycle counter
+ * on Cortex-M. Each metric keeps count/min/max/average, the standard
+ * deviation and a histogram with power-of-two microsecond buckets. Results
+ * are logged every CONFIG_APP_PERF_LOG_INTERVAL_MS and can be read with the
+ * "perf" shell command.
+ *
+ * With CONFIG_APP_PERF disabled every call compiles to nothing.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_PERF_H_
+#define APP_PERF_H_
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+enum perf_metric {
+	PERF_RENDER,
+	PERF_TRANSPOSE,
+	PERF_FLUSH,
+	PERF_FRAME,
+	PERF_INPUT,
+	PERF_METRIC_COUNT,
+};
+
+/* Histogram bucket i counts samples in [2^i, 2^(i+1)) microseconds */
+#define PERF_HIST_BUCKETS 16
+
+/* Statistics of one screen, as returned by perf_get_summary() */
+struct perf_summary {
+	uint64_t bytes;               /* Pixel bytes sent over SPI */
+	struct {
+		uint32_t count;           /* Number of samples */
+		uint32_t avg_us;
+		uint32_t min_us;          /* 0 when there are no samples */
+		uint32_t max_us;
+		uint32_t sd_us;           /* Standard deviation */
+	} metric[PERF_METRIC_COUNT];
+};
+
+#ifdef CONFIG_APP_PERF
+
+#include <zephyr/timing/timing.h>
+
+/* A cycle counter timestamp */
+typedef timing_t perf_ts_t;
+
+/* Start the cycle counter and the periodic summary. Call once at boot. */
+void perf_init(void);
+
+/* Attribute the following samples to the screen called 'name' */
+void perf_set_screen(const char *name);
+
+/* Current cycle counter value, to pass to perf_record() later */
+static inline perf_ts_t perf_now(void)
+{
+	return timing_counter_get();
+}
+
+/* Record one sample of 'metric' that started at 'start' and ends now */
+void perf_record(enum perf_metric metric, perf_ts_t start);
+
+/* Count pixel bytes sent over SPI */
+void perf_add_bytes(uint32_t bytes);
+
+/* Panel bus health: current SPI clock, and one failed page transfer */
+void perf_set_bus_hz(uint32_t hz);
+void perf_add_bus_error(void);
+
+/* Bracket one lv_timer_handler() call. The render time is only recorded
+ * when the call actually produced a frame (a transpose was recorded); so is
+ * the frame time, measured from the end of the previous such call. */
+void perf_render_begin(void);
+void perf_render_end(void);
+
+/*
+ * Input latency. perf_input_event() stamps a press (from its interrupt
+ * handler). The render run that follows brackets its work with
+ * perf_input_run_begin() / perf_input_run_end(); every frame queued in
+ * between is tagged (perf_input_frame_queued() returns true) and reported
+ * with perf_input_frame_sent() once its last byte is out. The sample ends
+ * at the last of those. One press is measured at a time.
+ */
+void perf_input_event(void);
+void perf_input_run_begin(void);
+void perf_input_run_end(void);
+bool perf_input_frame_queued(void);
+void perf_input_frame_sent(void);
+
+/* Log the summary now, and clear all statistics */
+void perf_log_summary(void);
+void perf_reset(void);
+
+/* Copy the statistics of screen 'name'. Returns -ENOENT if it has none. */
+int perf_get_summary(const char *name, struct perf_summary *sum);
+
+#else
+
+typedef uint32_t perf_ts_t;
+
+static inline void perf_init(void) {}
+static inline void perf_set_screen(const char *name) { (void)name; }
+static inline perf_ts_t perf_now(void) { return 0; }
+static inline void perf_record(enum perf_metric metric, perf_ts_t start)
+{
+	(void)metric;
+	(void)start;
+}
+static inline void perf_add_bytes(uint32_t bytes) { (void)bytes; }
+static inline void perf_set_bus_hz(uint32_t hz) { (void)hz; }
+static inline void perf_add_bus_error(void) {}
+static inline void perf_render_begin(void) {}
+static inline void perf_render_end(void) {}
+static inline void perf_input_event(void) {}
+static inline void perf_input_run_begin(void) {}
+static inline void perf_input_run_end(void) {}
+static inline bool perf_input_frame_queued(void) { return false; }
+static inline void perf_input_frame_sent(void) {}
+static inline void perf_log_summary(void) {}
+static inline void perf_reset(void) {}
+static inline int perf_get_summary(const char *name, struct perf_summary *sum)
+{
+	(void)name;
+	(void)sum;
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_APP_PERF */
+
+#endif /* APP_PERF_H_ */
@@ -0,0 +1,228 @@
+/*
+ * =============================================================================
+ * Raster primitives for canvas buffers
+ * =============================================================================
+ * All primitives reduce to horizontal spans or to pixel writes at a known
+ * address, so there is no per-pixel function call, format conversion or
+ * bounds check beyond the initial clipping.
+ *
+ * Supported formats:
+ *   L8     one byte per pixel: spans are a plain memset.
+ *   A1/I1  one bit per pixel, MSB = leftmost pixel: spans are a masked first
+ *          byte, a memset over the whole bytes in the middle and a masked
+ *          last byte. I1 buffers start with an 8-byte palette, which is
+ *          skipped.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raster.h"
+
+/* LVGL 9 puts a 2-entry palette (2 x 4 bytes) in front of I1 pixel data */
+#define RASTER_I1_PALETTE_SIZE 8
+
+static inline bool raster_is_1bpp(const struct raster *r)
+{
+	return r->cf != LV_COLOR_FORMAT_L8;
+}
+
+/* Byte value for a run of "on" or "off" pixels (same for every format) */
+static inline uint8_t raster_fill_byte(bool on)
+{
+	return on ? 0xFF : 0x00;
+}
+
+/* Set or clear the bits selected by mask in one byte */
+static inline void raster_put_bits(uint8_t *p, uint8_t mask, bool on)
+{
+	if (on) {
+		*p |= mask;
+	} else {
+		*p &= ~mask;
+	}
+}
+
+int raster_from_canvas(struct raster *r, lv_obj_t *canvas)
+{
+	lv_draw_buf_t *draw_buf = lv_canvas_get_draw_buf(canvas);
+
+	if (draw_buf == NULL) {
+		return -ENOTSUP;
+	}
+
+	r->buf = draw_buf->data;
+	r->cf = draw_buf->header.cf;
+
+	switch (r->cf) {
+	case LV_COLOR_FORMAT_L8:
+	case LV_COLOR_FORMAT_A1:
+		break;
+	case LV_COLOR_FORMAT_I1:
+		r->buf += RASTER_I1_PALETTE_SIZE;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	r->w = draw_buf->header.w;
+	r->h = draw_buf->header.h;
+	r->stride = draw_buf->header.stride;
+	return 0;
+}
+
+void raster_fill(const struct raster *r, bool on)
+{
+	memset(r->buf, raster_fill_byte(on), r->stride * r->h);
+}
+
+void raster_pixel(const struct raster *r, int32_t x, int32_t y, bool on)
+{
+	if (x < 0 || y < 0 || x >= r->w || y >= r->h) {
+		return;
+	}
+
+	if (raster_is_1bpp(r)) {
+		raster_put_bits(&r->buf[y * r->stride + (x >> 3)],
+				BIT(7 - (x & 7)), on);
+	} else {
+		r->buf[y * r->stride + x] = raster_fill_byte(on);
+	}
+}
+
+void raster_hspan(const struct raster *r, int32_t x1, int32_t x2, int32_t y,
+		  bool on)
+{
+	if (x1 > x2) {
+		int32_t t = x1;
+
+		x1 = x2;
+		x2 = t;
+	}
+
+	if (y < 0 || y >= r->h || x2 < 0 || x1 >= r->w) {
+		return;
+	}
+
+	x1 = MAX(x1, 0);
+	x2 = MIN(x2, r->w - 1);
+
+	uint8_t *row = &r->buf[y * r->stride];
+
+	if (!raster_is_1bpp(r)) {
+		memset(&row[x1], raster_fill_byte(on), x2 - x1 + 1);
+		return;
+	}
+
+	/* Masks of the pixels x1..7 in the first byte and 0..x2 in the last */
+	const int32_t b1 = x1 >> 3;
+	const int32_t b2 = x2 >> 3;
+	const uint8_t first = 0xFF >> (x1 & 7);
+	const uint8_t last = 0xFF << (7 - (x2 & 7));
+
+	if (b1 == b2) {
+		raster_put_bits(&row[b1], first & last, on);
+		return;
+	}
+
+	raster_put_bits(&row[b1], first, on);
+	memset(&row[b1 + 1], raster_fill_byte(on), b2 - b1 - 1);
+	raster_put_bits(&row[b2], last, on);
+}
+
+void raster_vspan(const struct raster *r, int32_t x, int32_t y1, int32_t y2,
+		  bool on)
+{
+	if (y1 > y2) {
+		int32_t t = y1;
+
+		y1 = y2;
+		y2 = t;
+	}
+
+	if (x < 0 || x >= r->w || y2 < 0 || y1 >= r->h) {
+		return;
+	}
+
+	y1 = MAX(y1, 0);
+	y2 = MIN(y2, r->h - 1);
+
+	if (raster_is_1bpp(r)) {
+		const uint8_t mask = BIT(7 - (x & 7));
+		uint8_t *p = &r->buf[y1 * r->stride + (x >> 3)];
+
+		for (int32_t y = y1; y <= y2; y++) {
+			raster_put_bits(p, mask, on);
+			p += r->stride;
+		}
+	} else {
+		const uint8_t value = raster_fill_byte(on);
+		uint8_t *p = &r->buf[y1 * r->stride + x];
+
+		for (int32_t y = y1; y <= y2; y++) {
+			*p = value;
+			p += r->stride;
+		}
+	}
+}
+
+void raster_line(const struct raster *r, int32_t x0, int32_t y0, int32_t x1,
+		 int32_t y1, bool on)
+{
+	if (y0 == y1) {
+		raster_hspan(r, x0, x1, y0, on);
+		return;
+	}
+	if (x0 == x1) {
+		raster_vspan(r, x0, y0, y1, on);
+		return;
+	}
+
+	/* Bresenham: step along the major axis, accumulate the error of the
+	 * minor axis and step it whenever the error crosses zero. */
+	const int32_t dx = abs(x1 - x0);
+	const int32_t dy = -abs(y1 - y0);
+	const int32_t sx = (x0 < x1) ? 1 : -1;
+	const int32_t sy = (y0 < y1) ? 1 : -1;
+	int32_t err = dx + dy;
+
+	while (1) {
+		raster_pixel(r, x0, y0, on);
+		if (x0 == x1 && y0 == y1) {
+			break;
+		}
+
+		int32_t e2 = 2 * err;
+
+		if (e2 >= dy) {
+			err += dy;
+			x0 += sx;
+		}
+		if (e2 <= dx) {
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+void raster_rect(const struct raster *r, int32_t x1, int32_t y1, int32_t x2,
+		 int32_t y2, bool on)
+{
+	raster_hspan(r, x1, x2, y1, on);
+	raster_hspan(r, x1, x2, y2, on);
+	raster_vspan(r, x1, y1, y2, on);
+	raster_vspan(r, x2, y1, y2, on);
+}
+
+void raster_fill_rect(const struct raster *r, int32_t x1, int32_t y1,
+		      int32_t x2, int32_t y2, bool on)
+{
+	for (int32_t y = MIN(y1, y2); y <= MAX(y1, y2); y++) {
+		raster_hspan(r, x1, x2, y, on);
+	}
+}
@@ -0,0 +1,64 @@
+/*
+ * =============================================================================
+ * Raster primitives for canvas buffers
+ * =============================================================================
+ * Small drawing library that writes straight into a canvas pixel buffer,
+ * instead of going through lv_canvas_set_px() for every single pixel.
+ * Spans are filled with memset (word-wide stores); lines use Bresenham's
+ * algorithm; everything is clipped to the buffer. Works on 1-bit (A1, I1)
+ * and 8-bit (L8) canvases.
+ *
+ * Usage:
+ *     struct raster r;
+ *     raster_from_canvas(&r, canvas);
+ *     raster_rect(&r, 0, 0, 79, 47, true);
+ *     raster_line(&r, 0, 0, 79, 47, true);
+ *     lv_obj_invalidate(canvas);   <- tell LVGL the canvas changed
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_RASTER_H_
+#define APP_RASTER_H_
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* A pixel buffer to draw into. Pixels are either on (white) or off. */
+struct raster {
+	uint8_t *buf;            /* First pixel (top-left) */
+	int32_t w;               /* Width in pixels */
+	int32_t h;               /* Height in pixels */
+	uint32_t stride;         /* Bytes per row */
+	lv_color_format_t cf;    /* Pixel format: L8, A1 or I1 */
+};
+
+/* Describe the pixel buffer of an LVGL canvas (L8, A1 or I1).
+ * Returns 0, or -ENOTSUP for other formats. */
+int raster_from_canvas(struct raster *r, lv_obj_t *canvas);
+
+/* Set every pixel of the buffer */
+void raster_fill(const struct raster *r, bool on);
+
+/* Single pixel */
+void raster_pixel(const struct raster *r, int32_t x, int32_t y, bool on);
+
+/* Horizontal span x1..x2 on row y, and vertical span y1..y2 on column x */
+void raster_hspan(const struct raster *r, int32_t x1, int32_t x2, int32_t y,
+		  bool on);
+void raster_vspan(const struct raster *r, int32_t x, int32_t y1, int32_t y2,
+		  bool on);
+
+/* Straight line between two points (both end points included) */
+void raster_line(const struct raster *r, int32_t x0, int32_t y0, int32_t x1,
+		 int32_t y1, bool on);
+
+/* Rectangle outline and filled rectangle, corners included */
+void raster_rect(const struct raster *r, int32_t x1, int32_t y1, int32_t x2,
+		 int32_t y2, bool on);
+void raster_fill_rect(const struct raster *r, int32_t x1, int32_t y1,
+		      int32_t x2, int32_t y2, bool on);
+
+#endif /* APP_RASTER_H_ */
@@ -0,0 +1,163 @@
+/*
+ * =============================================================================
+ * Event-driven LVGL render scheduler
+ * =============================================================================
+ * lv_timer_handler() returns how many milliseconds remain until the next
+ * LVGL timer (animation step, display refresh, ...) must run. We sleep on a
+ * semaphore with that timeout, so the thread wakes either:
+ *   - when LVGL needs it (timeout), or
+ *   - immediately when render_sched_wake() gives the semaphore.
+ *
+ * The frame-rate cap is applied on top: LVGL is never run again sooner than
+ * 1000 / CONFIG_APP_RENDER_MAX_FPS ms after the previous run.
+ *
+ * With CONFIG_APP_IDLE, a screen that stays unchanged long enough puts the
+ * scheduler into idle mode (see idle.c): LVGL timers are not run at all and
+ * the thread sleeps until render_sched_wake() is called.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+
+#include "idle.h"
+#include "perf.h"
+#include "render_sched.h"
+#include "ui.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(render_sched, LOG_LEVEL_INF);
+
+/* Shortest time between two LVGL runs, from the frame rate cap */
+#define RENDER_MIN_PERIOD_MS (1000 / CONFIG_APP_RENDER_MAX_FPS)
+
+/* Given by render_sched_wake(); a binary semaphore (max count 1) */
+static K_SEM_DEFINE(render_wake_sem, 0, 1);
+/* Given by render_sched_wake_now(): cuts the frame rate cap wait short */
+static K_SEM_DEFINE(render_now_sem, 0, 1);
+
+/* When LVGL was last run, for the frame rate cap */
+static int64_t render_last_run_ms;
+
+/* Time left until 'until_ms', or forever for RENDER_SCHED_FOREVER */
+static k_timeout_t render_timeout(int64_t until_ms, int64_t now_ms)
+{
+	return (until_ms == RENDER_SCHED_FOREVER) ? K_FOREVER :
+						    K_MSEC(until_ms - now_ms);
+}
+
+void render_sched_wake(void)
+{
+	k_sem_give(&render_wake_sem);
+}
+
+void render_sched_wake_now(void)
+{
+	k_sem_give(&render_now_sem);
+	k_sem_give(&render_wake_sem);
+}
+
+/* Display event: something was invalidated and needs to be redrawn */
+static void render_invalidate_cb(lv_event_t *e)
+{
+	ARG_UNUSED(e);
+
+	idle_note_activity();
+	render_sched_wake();
+}
+
+int render_sched_init(void)
+{
+	lv_display_t *disp = lv_display_get_next(NULL);
+
+	if (disp == NULL) {
+		return -ENODEV;
+	}
+
+	/* Every display (a second panel too) wakes the same thread */
+	for (; disp != NULL; disp = lv_display_get_next(disp)) {
+		lv_display_add_event_cb(disp, render_invalidate_cb,
+					LV_EVENT_INVALIDATE_AREA, NULL);
+	}
+	return 0;
+}
+
+void render_sched_run_now(void)
+{
+	idle_exit();
+	k_sem_reset(&render_wake_sem);
+	k_sem_reset(&render_now_sem);
+	perf_input_run_begin();
+	ui_apply_pending();
+	perf_render_begin();
+	lv_timer_handler();
+	perf_render_end();
+	perf_input_run_end();
+	render_last_run_ms = k_uptime_get();
+}
+
+void render_sched_run_until(int64_t deadline_ms)
+{
+	int64_t now = k_uptime_get();
+
+	while (now < deadline_ms) {
+		/* Idle: LVGL timers are gated, only a wake-up brings us back */
+		if (idle_update(now)) {
+			if (k_sem_take(&render_wake_sem,
+				       render_timeout(deadline_ms, now)) != 0) {
+				break;
+			}
+			idle_exit();
+			now = k_uptime_get();
+		}
+
+		/* Frame rate cap: don't run LVGL again too soon, unless
+		 * render_sched_wake_now() asks for it */
+		int64_t earliest = render_last_run_ms + RENDER_MIN_PERIOD_MS;
+
+		if (now < earliest) {
+			k_sem_take(&render_now_sem,
+				   K_MSEC(MIN(earliest, deadline_ms) - now));
+			now = k_uptime_get();
+			if (now >= deadline_ms) {
+				break;
+			}
+		}
+
+		/* Wake-ups requested before this run are handled by this run */
+		k_sem_reset(&render_wake_sem);
+		k_sem_reset(&render_now_sem);
+
+		/* Posted widget updates become part of this frame (and so
+		 * does a button press that caused them, for its latency) */
+		perf_input_run_begin();
+		ui_apply_pending();
+
+		perf_render_begin();
+		uint32_t next_ms = lv_timer_handler();
+		perf_render_end();
+		perf_input_run_end();
+
+		render_last_run_ms = k_uptime_get();
+
+		/* LV_NO_TIMER_READY: no timer pending, sleep until the deadline */
+		int64_t wake_at = (next_ms == LV_NO_TIMER_READY) ?
+				  deadline_ms :
+				  MIN(render_last_run_ms + next_ms, deadline_ms);
+
+		if (wake_at > render_last_run_ms) {
+			k_sem_take(&render_wake_sem,
+				   render_timeout(wake_at, render_last_run_ms));
+		}
+
+		now = k_uptime_get();
+	}
+}
+
+void render_sched_run_for(uint32_t duration_ms)
+{
+	render_sched_run_until(k_uptime_get() + duration_ms);
+}
@@ -0,0 +1,59 @@
+/*
+ * =============================================================================
+ * Event-driven LVGL render scheduler
+ * =============================================================================
+ * Instead of calling lv_task_handler() and then sleeping a fixed 30 ms, the
+ * scheduler sleeps exactly until LVGL's next timer is due, or until someone
+ * calls render_sched_wake() (for example because a widget changed). A frame
+ * rate cap (CONFIG_APP_RENDER_MAX_FPS) keeps busy screens from rendering
+ * more often than the panel can usefully show.
+ *
+ * Updates posted through ui.h are applied right before each LVGL run.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_RENDER_SCHED_H_
+#define APP_RENDER_SCHED_H_
+
+#include <stdint.h>
+
+/*
+ * Hook the scheduler into the default LVGL display, so every invalidated
+ * area wakes it up. Call once after LVGL is initialized.
+ */
+int render_sched_init(void);
+
+/*
+ * Run LVGL (timers, animations, rendering) for duration_ms milliseconds,
+ * sleeping whenever there is nothing to do. Must be called from the thread
+ * that owns LVGL.
+ */
+void render_sched_run_for(uint32_t duration_ms);
+
+/* Deadline for render_sched_run_until() that never comes */
+#define RENDER_SCHED_FOREVER INT64_MAX
+
+/* Same as render_sched_run_for(), with an absolute k_uptime_get() deadline */
+void render_sched_run_until(int64_t deadline_ms);
+
+/*
+ * Run LVGL once right now (leaving idle mode first if needed), ignoring the
+ * frame rate cap. Use it to push a freshly built screen out immediately.
+ */
+void render_sched_run_now(void);
+
+/*
+ * Ask the scheduler to run LVGL as soon as the frame rate cap allows.
+ * Safe to call from any thread and from interrupt handlers.
+ */
+void render_sched_wake(void);
+
+/*
+ * Same, for changes someone is waiting to see (a button press, a screen
+ * switch): the next run does not wait for the frame rate cap.
+ */
+void render_sched_wake_now(void);
+
+#endif /* APP_RENDER_SCHED_H_ */
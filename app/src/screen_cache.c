@@ -0,0 +1,74 @@
+/*
+ * =============================================================================
+ * Screen cache: build every screen once, then switch in O(1)
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mem_stats.h>
+#include <lvgl.h>
+#include <lvgl_mem.h>
+
+#include "perf.h"
+#include "screen_cache.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(screen_cache, LOG_LEVEL_INF);
+
+/* The screen currently loaded, so its leave() hook can be called */
+static struct screen *screen_current;
+
+static void screen_build(struct screen *s)
+{
+	if (s->obj != NULL) {
+		return;
+	}
+
+	s->obj = lv_obj_create(NULL);
+	s->build(s->obj);
+
+	screen_cache_log_heap(s->name);
+}
+
+void screen_cache_show(struct screen *s)
+{
+	if (s == screen_current) {
+		return;
+	}
+
+	screen_build(s);
+
+	if (screen_current != NULL && screen_current->leave != NULL) {
+		screen_current->leave();
+	}
+
+	/* The old screen stays alive (no auto-delete), ready for next time */
+	lv_screen_load(s->obj);
+	screen_current = s;
+
+	if (s->enter != NULL) {
+		s->enter();
+	}
+
+	/* Frame timings from now on belong to this screen */
+	perf_set_screen(s->name);
+}
+
+void screen_cache_build_all(struct screen *screens, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		screen_build(&screens[i]);
+	}
+}
+
+void screen_cache_log_heap(const char *tag)
+{
+	struct sys_memory_stats stats;
+
+	lvgl_heap_stats(&stats);
+	LOG_INF("LVGL heap after %s: %zu used, %zu peak, %zu free", tag,
+		stats.allocated_bytes, stats.max_allocated_bytes,
+		stats.free_bytes);
+}
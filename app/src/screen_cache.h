@@ -0,0 +1,48 @@
+/*
+ * =============================================================================
+ * Screen cache: build every screen once, then switch in O(1)
+ * =============================================================================
+ * Each screen is its own top-level LVGL object (lv_obj_create(NULL)). Its
+ * widgets are created the first time it is shown (or at boot with
+ * screen_cache_build_all()), and after that switching screens is a single
+ * lv_screen_load(): no objects are deleted or re-created, so the LVGL heap
+ * stops churning and no layout pass is needed for widgets that already exist.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_SCREEN_CACHE_H_
+#define APP_SCREEN_CACHE_H_
+
+#include <lvgl.h>
+#include <stddef.h>
+
+struct screen {
+	const char *name;
+	/* Create the widgets of the screen on 'scr' (called once) */
+	void (*build)(lv_obj_t *scr);
+	/* Optional: called right after the screen has been loaded */
+	void (*enter)(void);
+	/* Optional: runs in the application thread while the screen is shown
+	 * (e.g. animations). It must not call LVGL: it posts updates through
+	 * ui.h instead. */
+	void (*run)(void);
+	/* Optional: called just before another screen replaces this one */
+	void (*leave)(void);
+	/* The cached LVGL screen object, NULL until built */
+	lv_obj_t *obj;
+};
+
+/* Make 's' the active screen, building it first if needed, and call its
+ * enter hook. Does not call s->run; the caller decides when to run it.
+ * build, enter and leave run in the thread that owns LVGL. */
+void screen_cache_show(struct screen *s);
+
+/* Build every screen in the table ahead of time (e.g. at boot) */
+void screen_cache_build_all(struct screen *screens, size_t count);
+
+/* Log LVGL heap usage, including the high-water mark */
+void screen_cache_log_heap(const char *tag);
+
+#endif /* APP_SCREEN_CACHE_H_ */
@@ -0,0 +1,133 @@
+/*
+ * =============================================================================
+ * SPI clock selection for the panel bus
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/drivers/spi.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "spi_tune.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(spi_tune, LOG_LEVEL_INF);
+
+/* The rates the nRF52 SPIM can generate, slowest first */
+static const uint32_t spi_tune_rates[] = {
+	125000, 250000, 500000, 1000000, 2000000, 4000000, 8000000,
+};
+
+#define SPI_TUNE_PATTERN_LEN 64
+
+#ifdef CONFIG_APP_SPI_TUNE_LOOPBACK
+/* One spi_tune() run per panel */
+#define SPI_TUNE_MAX_RUNS 2
+
+/*
+ * One config per run and rate. SPI drivers only reconfigure the bus when
+ * they are given a different spi_config pointer (spi_context_configured()
+ * compares pointers, not contents), so reusing one struct for every rate
+ * would test them all at the first one. For the same reason a second
+ * panel on the bus must not reuse the configs of the first. Only used at
+ * boot, from one thread.
+ */
+static struct spi_config spi_tune_cfgs[SPI_TUNE_MAX_RUNS][ARRAY_SIZE(spi_tune_rates)];
+static int spi_tune_runs;
+
+/* Send a pattern with CS inactive and check that MISO echoes it */
+static int spi_tune_check(const struct spi_dt_spec *spec, int rate)
+{
+	struct spi_config *cfg = &spi_tune_cfgs[spi_tune_runs][rate];
+	const uint32_t hz = spi_tune_rates[rate];
+	uint8_t tx[SPI_TUNE_PATTERN_LEN];
+	uint8_t rx[SPI_TUNE_PATTERN_LEN];
+	const struct spi_buf tx_buf = { .buf = tx, .len = sizeof(tx) };
+	const struct spi_buf rx_buf = { .buf = rx, .len = sizeof(rx) };
+	const struct spi_buf_set tx_set = { .buffers = &tx_buf, .count = 1 };
+	const struct spi_buf_set rx_set = { .buffers = &rx_buf, .count = 1 };
+	uint32_t lfsr = 0xACE1U ^ hz;   /* Never 0 for these rates */
+	int errors = 0;
+
+	*cfg = spec->config;
+	cfg->frequency = hz;
+	cfg->operation &= ~(SPI_HOLD_ON_CS | SPI_LOCK_ON);
+	/* No chip select: the panel must not take the pattern as data */
+	memset(&cfg->cs, 0, sizeof(cfg->cs));
+
+	for (int round = 0; round < CONFIG_APP_SPI_TUNE_ROUNDS; round++) {
+		/* Pseudo-random bytes (xorshift32), so every bit transition
+		 * shows up somewhere in the pattern */
+		for (int i = 0; i < sizeof(tx); i++) {
+			lfsr ^= lfsr << 13;
+			lfsr ^= lfsr >> 17;
+			lfsr ^= lfsr << 5;
+			tx[i] = (uint8_t)lfsr;
+		}
+		memset(rx, 0, sizeof(rx));
+
+		int err = spi_transceive(spec->bus, cfg, &tx_set, &rx_set);
+
+		if (err) {
+			return err;
+		}
+
+		if (memcmp(tx, rx, sizeof(tx)) != 0) {
+			errors++;
+		}
+	}
+
+	return errors ? -EIO : 0;
+}
+#endif /* CONFIG_APP_SPI_TUNE_LOOPBACK */
+
+uint32_t spi_tune(struct spi_dt_spec *spec)
+{
+	const uint32_t limit = spec->config.frequency;
+	uint32_t best = 0;
+
+#ifdef CONFIG_APP_SPI_TUNE_LOOPBACK
+	if (spi_tune_runs == SPI_TUNE_MAX_RUNS) {
+		LOG_ERR("Too many spi_tune() runs, using %u Hz", limit);
+		return limit;
+	}
+#endif
+
+	for (int i = 0; i < ARRAY_SIZE(spi_tune_rates); i++) {
+		const uint32_t hz = spi_tune_rates[i];
+
+		if (hz > limit) {
+			break;
+		}
+
+#ifdef CONFIG_APP_SPI_TUNE_LOOPBACK
+		int err = spi_tune_check(spec, i);
+
+		if (err) {
+			LOG_WRN("%u Hz failed (%d)", hz, err);
+			break;
+		}
+#endif
+		best = hz;
+	}
+
+#ifdef CONFIG_APP_SPI_TUNE_LOOPBACK
+	spi_tune_runs++;
+#endif
+
+	if (best == 0U) {
+		/* Not even the slowest rate worked: keep the devicetree value */
+		LOG_ERR("No working SPI clock found, using %u Hz", limit);
+		return limit;
+	}
+
+	spec->config.frequency = best;
+	LOG_INF("Panel SPI clock: %u Hz (%s, devicetree limit %u Hz)", best,
+		IS_ENABLED(CONFIG_APP_SPI_TUNE_LOOPBACK) ? "loopback tested" :
+							   "untested",
+		limit);
+	return best;
+}
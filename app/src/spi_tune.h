@@ -0,0 +1,44 @@
+/*
+ * =============================================================================
+ * SPI clock selection for the panel bus
+ * =============================================================================
+ * The devicetree spi-max-frequency is only an upper bound: the nRF52832
+ * SPIM tops out at 8 MHz and runs only a few fixed rates, and SH1106
+ * modules and their wiring differ in what they tolerate.
+ *
+ * spi_tune() picks the clock once at boot. The SH1106 cannot be read back
+ * over SPI, so a real test needs MISO wired to MOSI
+ * (CONFIG_APP_SPI_TUNE_LOOPBACK): a pseudo-random pattern is then sent at
+ * each rate from the slowest upwards, with chip select left inactive so the
+ * panel ignores it, and the fastest rate whose echo came back intact is
+ * kept. Without the loopback the fastest supported rate at or below the
+ * devicetree limit is used.
+ *
+ * The chosen clock is reported through perf_set_bus_hz().
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_SPI_TUNE_H_
+#define APP_SPI_TUNE_H_
+
+#include <zephyr/drivers/spi.h>
+#include <stdint.h>
+
+#ifdef CONFIG_APP_SPI_TUNE
+
+/* Choose the clock for 'spec' and store it in spec->config.frequency.
+ * Returns the chosen frequency in Hz. */
+uint32_t spi_tune(struct spi_dt_spec *spec);
+
+#else
+
+static inline uint32_t spi_tune(struct spi_dt_spec *spec)
+{
+	return spec->config.frequency;
+}
+
+#endif /* CONFIG_APP_SPI_TUNE */
+
+#endif /* APP_SPI_TUNE_H_ */
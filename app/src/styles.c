@@ -0,0 +1,171 @@
+/*
+ * =============================================================================
+ * Shared styles for the demo widgets
+ * =============================================================================
+ * Each style is a property list ended by LV_STYLE_CONST_PROPS_END. The few
+ * values that are not compile-time constants (the glyph cache copies of the
+ * fonts, the encoded scroll speed) are written into their list once, on the
+ * first styles_apply(), before any object refers to it.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+
+#include "glyph_cache.h"
+#include "styles.h"
+
+#define STYLE_WHITE LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)
+
+/* A style may cover more than one part of a widget (bar, arc) */
+#define STYLE_MAX_PARTS 2
+
+/* --- Text ------------------------------------------------------------------*/
+static lv_style_const_prop_t style_title_props[] = {
+	LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_14),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_title, style_title_props);
+
+static lv_style_const_prop_t style_small_props[] = {
+	LV_STYLE_CONST_TEXT_FONT(&lv_font_unscii_8),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_small, style_small_props);
+
+/* A scrolling label's speed is its animation duration (lv_anim_speed()) */
+static lv_style_const_prop_t style_scroll_props[] = {
+	LV_STYLE_CONST_TEXT_FONT(&lv_font_unscii_8),
+	LV_STYLE_CONST_ANIM_DURATION(0),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_scroll, style_scroll_props);
+
+/* --- Shapes ----------------------------------------------------------------*/
+static const lv_style_const_prop_t style_line_props[] = {
+	LV_STYLE_CONST_LINE_WIDTH(1),
+	LV_STYLE_CONST_LINE_COLOR(STYLE_WHITE),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_line, style_line_props);
+
+/* Outline only: a half-transparent track is just noise on a 1-bit panel */
+static const lv_style_const_prop_t style_bar_props[] = {
+	LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+	LV_STYLE_CONST_BORDER_WIDTH(1),
+	LV_STYLE_CONST_BORDER_COLOR(STYLE_WHITE),
+	LV_STYLE_CONST_RADIUS(0),
+	LV_STYLE_CONST_PAD_TOP(2),
+	LV_STYLE_CONST_PAD_BOTTOM(2),
+	LV_STYLE_CONST_PAD_LEFT(2),
+	LV_STYLE_CONST_PAD_RIGHT(2),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_bar, style_bar_props);
+
+static const lv_style_const_prop_t style_bar_indic_props[] = {
+	LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+	LV_STYLE_CONST_BG_COLOR(STYLE_WHITE),
+	LV_STYLE_CONST_RADIUS(0),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_bar_indic, style_bar_indic_props);
+
+static const lv_style_const_prop_t style_arc_props[] = {
+	LV_STYLE_CONST_ARC_WIDTH(1),
+	LV_STYLE_CONST_ARC_COLOR(STYLE_WHITE),
+	LV_STYLE_CONST_ARC_ROUNDED(false),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_arc, style_arc_props);
+
+static const lv_style_const_prop_t style_arc_indic_props[] = {
+	LV_STYLE_CONST_ARC_WIDTH(4),
+	LV_STYLE_CONST_ARC_COLOR(STYLE_WHITE),
+	LV_STYLE_CONST_ARC_ROUNDED(false),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_arc_indic, style_arc_indic_props);
+
+static const lv_style_const_prop_t style_mono_image_props[] = {
+	LV_STYLE_CONST_IMAGE_RECOLOR(STYLE_WHITE),
+	LV_STYLE_CONST_PROPS_END,
+};
+static LV_STYLE_CONST_INIT(style_mono_image, style_mono_image_props);
+
+/* --- Table -----------------------------------------------------------------*/
+struct style_part {
+	const lv_style_t *style;  /* NULL = no more parts */
+	lv_style_selector_t selector;
+};
+
+static const struct style_part style_table[STYLE_COUNT][STYLE_MAX_PARTS] = {
+	[STYLE_TITLE]      = { { &style_title, LV_PART_MAIN } },
+	[STYLE_SMALL]      = { { &style_small, LV_PART_MAIN } },
+	[STYLE_SCROLL]     = { { &style_scroll, LV_PART_MAIN } },
+	[STYLE_LINE]       = { { &style_line, LV_PART_MAIN } },
+	[STYLE_BAR]        = { { &style_bar, LV_PART_MAIN },
+			       { &style_bar_indic, LV_PART_INDICATOR } },
+	[STYLE_ARC]        = { { &style_arc, LV_PART_MAIN },
+			       { &style_arc_indic, LV_PART_INDICATOR } },
+	[STYLE_MONO_IMAGE] = { { &style_mono_image, LV_PART_MAIN } },
+};
+
+static bool styles_ready;
+
+static void styles_patch(lv_style_const_prop_t *props, lv_style_prop_t prop,
+			 lv_style_value_t value)
+{
+	for (; props->prop != LV_STYLE_PROP_INV; props++) {
+		if (props->prop == prop) {
+			props->value = value;
+		}
+	}
+}
+
+static void styles_init(void)
+{
+	styles_patch(style_title_props, LV_STYLE_TEXT_FONT,
+		     (lv_style_value_t){ .ptr = glyph_cache_font(&lv_font_montserrat_14) });
+	styles_patch(style_small_props, LV_STYLE_TEXT_FONT,
+		     (lv_style_value_t){ .ptr = glyph_cache_font(&lv_font_unscii_8) });
+	styles_patch(style_scroll_props, LV_STYLE_TEXT_FONT,
+		     (lv_style_value_t){ .ptr = glyph_cache_font(&lv_font_unscii_8) });
+	/* 20 px/s: LVGL's default 40 px/s is too jumpy on a 128 px panel */
+	styles_patch(style_scroll_props, LV_STYLE_ANIM_DURATION,
+		     (lv_style_value_t){ .num = lv_anim_speed(20) });
+
+	styles_ready = true;
+}
+
+void styles_apply(lv_obj_t *obj, enum style_id id)
+{
+	__ASSERT_NO_MSG(id < STYLE_COUNT);
+
+	if (!styles_ready) {
+		styles_init();
+	}
+
+	for (int i = 0; i < STYLE_MAX_PARTS; i++) {
+		const struct style_part *part = &style_table[id][i];
+
+		if (part->style == NULL) {
+			break;
+		}
+
+#ifdef CONFIG_APP_SHARED_STYLES
+		lv_obj_add_style(obj, part->style, part->selector);
+#else
+		/* For comparison: the same properties as local styles */
+		const lv_style_const_prop_t *p = part->style->values_and_props;
+
+		for (; p->prop != LV_STYLE_PROP_INV; p++) {
+			lv_obj_set_local_style_prop(obj, p->prop, p->value,
+						    part->selector);
+		}
+#endif
+	}
+}
@@ -0,0 +1,46 @@
+/*
+ * =============================================================================
+ * Shared styles for the demo widgets
+ * =============================================================================
+ * lv_obj_set_style_text_font() and the other lv_obj_set_style_*() setters
+ * give each object its own local style: a heap-allocated lv_style_t per
+ * object, which LVGL also looks through first whenever a property of that
+ * object is resolved during a redraw.
+ *
+ * Here every look the demos use is one const style (LV_STYLE_CONST_INIT),
+ * shared by all the objects that have it. Const styles take no heap and
+ * cannot be changed after they are added, so LVGL never has to report
+ * a style change for them. styles_apply() adds one to an object.
+ *
+ * With CONFIG_APP_SHARED_STYLES=n the same properties are set as local
+ * styles instead, so the benchmark's heap_used and render_us show what
+ * sharing saves.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_STYLES_H_
+#define APP_STYLES_H_
+
+#include <lvgl.h>
+
+enum style_id {
+	STYLE_TITLE,              /* Montserrat 14 */
+	STYLE_SMALL,              /* UNSCII 8 */
+	STYLE_SCROLL,             /* UNSCII 8 scrolling at 20 px/s */
+	STYLE_LINE,               /* 1 px white line */
+	STYLE_BAR,                /* Outlined bar with a solid indicator */
+	STYLE_ARC,                /* Thin track, 4 px indicator */
+	STYLE_MONO_IMAGE,         /* A1/I1 canvases drawn white */
+	STYLE_COUNT,
+};
+
+/*
+ * Add the style 'id' (all of its parts) to 'obj'. The first call fills in
+ * what is only known at run time (the glyph cache fonts), so call it from
+ * the thread that owns LVGL.
+ */
+void styles_apply(lv_obj_t *obj, enum style_id id);
+
+#endif /* APP_STYLES_H_ */
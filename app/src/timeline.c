@@ -0,0 +1,51 @@
+/*
+ * =============================================================================
+ * Fixed-rate animation timeline on the monotonic clock
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "timeline.h"
+
+void timeline_start(struct timeline *tl, int32_t duration_ms, int32_t period_ms)
+{
+	tl->start_ms = k_uptime_get();
+	tl->due_ms = tl->start_ms;
+	tl->duration_ms = duration_ms;
+	tl->period_ms = MAX(period_ms, 1);
+	tl->dropped = 0;
+}
+
+int32_t timeline_next(struct timeline *tl)
+{
+	const int64_t end_ms = tl->start_ms + tl->duration_ms;
+	int64_t now = k_uptime_get();
+
+	if (tl->due_ms > end_ms) {
+		return -1;
+	}
+
+	if (now < tl->due_ms) {
+		k_sleep(K_TIMEOUT_ABS_MS(tl->due_ms));
+		now = k_uptime_get();
+	} else if (now >= tl->due_ms + tl->period_ms) {
+		/* Late by one period or more: skip the ticks that are past */
+		int64_t late = (now - tl->due_ms) / tl->period_ms;
+
+		tl->dropped += late;
+		tl->due_ms += late * tl->period_ms;
+	}
+
+	/* The final tick lands on the end, so the last state is always shown */
+	if (tl->due_ms < end_ms) {
+		tl->due_ms = MIN(tl->due_ms + tl->period_ms, end_ms);
+	} else {
+		tl->due_ms = end_ms + 1;
+	}
+
+	return (int32_t)MIN(now - tl->start_ms, (int64_t)tl->duration_ms);
+}
@@ -0,0 +1,59 @@
+/*
+ * =============================================================================
+ * Fixed-rate animation timeline on the monotonic clock
+ * =============================================================================
+ * An animation loop that sleeps one period and then adds that period to its
+ * own "elapsed" counter runs slow: every update, log line or late wake-up is
+ * added on top, so the animation stretches when frames are slow. A timeline
+ * instead keeps one absolute start time (k_uptime_get()) and hands out the
+ * real elapsed time at every tick:
+ *
+ *   - ticks are due at start + n * period, whatever the loop did in between
+ *   - a tick that is already past when the loop comes back is dropped, not
+ *     caught up: the next wake-up is the next due tick in the future
+ *   - it ends exactly 'duration' after the start
+ *
+ * State derived from the returned time (a bar value, a clock) is therefore
+ * correct even when frames are dropped.
+ *
+ *     struct timeline tl;
+ *     int32_t t;
+ *
+ *     timeline_start(&tl, 6000, 30);
+ *     while ((t = timeline_next(&tl)) >= 0) {
+ *         ui_set_value(SLOT, timeline_scale(t, 6000, 100));
+ *     }
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_TIMELINE_H_
+#define APP_TIMELINE_H_
+
+#include <stdint.h>
+
+struct timeline {
+	int64_t start_ms;         /* k_uptime_get() at timeline_start() */
+	int64_t due_ms;           /* Next tick */
+	int32_t duration_ms;
+	int32_t period_ms;
+	uint32_t dropped;         /* Ticks skipped because they were late */
+};
+
+void timeline_start(struct timeline *tl, int32_t duration_ms, int32_t period_ms);
+
+/*
+ * Sleep until the next due tick and return the time since the start in ms
+ * (0 on the first call, which does not sleep). Returns -1 once 'duration'
+ * has passed; the last tick before that is clamped to the duration.
+ */
+int32_t timeline_next(struct timeline *tl);
+
+/* Map t in [0, duration] linearly onto [0, to] */
+static inline int32_t timeline_scale(int32_t t, int32_t duration, int32_t to)
+{
+	return (int32_t)(((int64_t)t * to) / duration);
+}
+
+#endif /* APP_TIMELINE_H_ */
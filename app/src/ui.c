@@ -0,0 +1,235 @@
+/*
+ * =============================================================================
+ * UI thread and update queue
+ * =============================================================================
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <lvgl.h>
+#include <string.h>
+
+#include "render_sched.h"
+#include "screen_cache.h"
+#include "ui.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ui, LOG_LEVEL_INF);
+
+/* One bit per slot in an atomic_t bitmap */
+BUILD_ASSERT(CONFIG_APP_UI_VALUE_SLOTS <= ATOMIC_BITS);
+BUILD_ASSERT(CONFIG_APP_UI_TEXT_SLOTS <= 32);
+
+struct ui_value_binding {
+	lv_obj_t *obj;
+	ui_value_fn fn;           /* Generic setter, or NULL for a label */
+	ui_format_fn format;      /* Label formatter (fn == NULL) */
+	bool shown_valid;         /* 'shown' holds what the widget displays */
+	int32_t shown;
+};
+
+struct ui_text_msg {
+	uint8_t slot;
+	char text[CONFIG_APP_UI_TEXT_LEN];
+};
+
+/* --- Shared with producers (atomics and the message queue only) -----------*/
+static atomic_t ui_values[CONFIG_APP_UI_VALUE_SLOTS];
+static atomic_t ui_values_dirty;
+/* Slots that have been posted at least once (their value means something) */
+static atomic_t ui_values_posted;
+static atomic_ptr_t ui_screen_req;
+K_MSGQ_DEFINE(ui_text_q, sizeof(struct ui_text_msg),
+	      CONFIG_APP_UI_TEXT_QUEUE_DEPTH, 4);
+
+/* --- UI thread only --------------------------------------------------------*/
+static struct ui_value_binding ui_value_bindings[CONFIG_APP_UI_VALUE_SLOTS];
+static lv_obj_t *ui_text_bindings[CONFIG_APP_UI_TEXT_SLOTS];
+/* Newest text per slot, waiting to be applied */
+static char ui_texts[CONFIG_APP_UI_TEXT_SLOTS][CONFIG_APP_UI_TEXT_LEN];
+static uint32_t ui_texts_pending;
+/*
+ * Label text buffers. Labels are set with lv_label_set_text_static(), so
+ * LVGL keeps pointing at these instead of allocating a copy on every update.
+ * They are only rewritten when the text actually changes.
+ */
+static char ui_text_shown[CONFIG_APP_UI_TEXT_SLOTS][CONFIG_APP_UI_TEXT_LEN];
+static char ui_value_text[CONFIG_APP_UI_VALUE_SLOTS][CONFIG_APP_UI_TEXT_LEN];
+
+void ui_show_screen(struct screen *s)
+{
+	atomic_ptr_set(&ui_screen_req, s);
+	/* Someone is looking at the screen switch: skip the frame rate cap */
+	render_sched_wake_now();
+}
+
+int ui_set_value(unsigned int slot, int32_t value)
+{
+	if (slot >= CONFIG_APP_UI_VALUE_SLOTS) {
+		return -EINVAL;
+	}
+
+	bool posted_before = atomic_test_and_set_bit(&ui_values_posted, slot);
+
+	/* Same value as last time: it is pending or shown already */
+	if (atomic_set(&ui_values[slot], value) == value && posted_before) {
+		return 0;
+	}
+
+	atomic_set_bit(&ui_values_dirty, slot);
+	render_sched_wake();
+	return 0;
+}
+
+int ui_set_text(unsigned int slot, const char *text)
+{
+	struct ui_text_msg msg = { .slot = slot };
+
+	if (slot >= CONFIG_APP_UI_TEXT_SLOTS) {
+		return -EINVAL;
+	}
+
+	strncpy(msg.text, text, sizeof(msg.text) - 1);
+
+	/* Never wait: a full queue means the UI thread is starved anyway */
+	if (k_msgq_put(&ui_text_q, &msg, K_NO_WAIT) != 0) {
+		return -ENOMSG;
+	}
+
+	render_sched_wake();
+	return 0;
+}
+
+void ui_bind_value(unsigned int slot, lv_obj_t *obj, ui_value_fn fn)
+{
+	__ASSERT_NO_MSG(slot < CONFIG_APP_UI_VALUE_SLOTS);
+
+	ui_value_bindings[slot] = (struct ui_value_binding){
+		.obj = obj,
+		.fn = fn,
+	};
+}
+
+void ui_bind_label(unsigned int slot, lv_obj_t *label, ui_format_fn format)
+{
+	__ASSERT_NO_MSG(slot < CONFIG_APP_UI_VALUE_SLOTS);
+
+	ui_value_bindings[slot] = (struct ui_value_binding){
+		.obj = label,
+		.format = format,
+	};
+	ui_value_text[slot][0] = '\0';
+}
+
+void ui_bind_text(unsigned int slot, lv_obj_t *label)
+{
+	__ASSERT_NO_MSG(slot < CONFIG_APP_UI_TEXT_SLOTS);
+
+	ui_text_bindings[slot] = label;
+	ui_text_shown[slot][0] = '\0';
+}
+
+static void ui_apply_values(void)
+{
+	atomic_val_t dirty = atomic_clear(&ui_values_dirty);
+
+	while (dirty != 0) {
+		unsigned int slot = __builtin_ctzl(dirty);
+		struct ui_value_binding *b = &ui_value_bindings[slot];
+
+		dirty &= ~BIT(slot);
+
+		if (b->obj == NULL) {
+			/* Not bound yet: keep it for when it is */
+			atomic_set_bit(&ui_values_dirty, slot);
+			continue;
+		}
+
+		/* A producer may have posted an even newer value since the
+		 * bitmap was cleared: fine, that one is shown a frame early */
+		int32_t value = atomic_get(&ui_values[slot]);
+
+		/* Unchanged: no setter call, no invalidation, no re-layout */
+		if (b->shown_valid && b->shown == value) {
+			continue;
+		}
+		b->shown = value;
+		b->shown_valid = true;
+
+		if (b->fn != NULL) {
+			b->fn(b->obj, value);
+			continue;
+		}
+
+		char *buf = ui_value_text[slot];
+		char text[CONFIG_APP_UI_TEXT_LEN];
+
+		/* Formatting can give the same text for a different value
+		 * (e.g. milliseconds shown as seconds) */
+		b->format(text, sizeof(text), value);
+		if (strcmp(text, buf) != 0) {
+			strcpy(buf, text);
+			lv_label_set_text_static(b->obj, buf);
+		}
+	}
+}
+
+static void ui_apply_texts(void)
+{
+	struct ui_text_msg msg;
+
+	/* Drain the queue first, so only the newest text per slot is set */
+	while (k_msgq_get(&ui_text_q, &msg, K_NO_WAIT) == 0) {
+		memcpy(ui_texts[msg.slot], msg.text, sizeof(msg.text));
+		ui_texts_pending |= BIT(msg.slot);
+	}
+
+	for (unsigned int slot = 0; slot < CONFIG_APP_UI_TEXT_SLOTS; slot++) {
+		if ((ui_texts_pending & BIT(slot)) == 0U ||
+		    ui_text_bindings[slot] == NULL) {
+			continue;
+		}
+
+		ui_texts_pending &= ~BIT(slot);
+
+		if (strcmp(ui_texts[slot], ui_text_shown[slot]) != 0) {
+			strcpy(ui_text_shown[slot], ui_texts[slot]);
+			lv_label_set_text_static(ui_text_bindings[slot],
+						 ui_text_shown[slot]);
+		}
+	}
+}
+
+void ui_apply_pending(void)
+{
+	struct screen *s = atomic_ptr_clear(&ui_screen_req);
+
+	/* Screen first: building it binds its slots */
+	if (s != NULL) {
+		screen_cache_show(s);
+	}
+
+	ui_apply_values();
+	ui_apply_texts();
+}
+
+static void ui_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	render_sched_run_until(RENDER_SCHED_FOREVER);
+}
+
+/* Created stopped; ui_start() hands LVGL over once boot code is done */
+K_THREAD_DEFINE(ui_tid, CONFIG_APP_UI_STACK_SIZE, ui_thread, NULL, NULL, NULL,
+		CONFIG_APP_UI_THREAD_PRIORITY, 0, SYS_FOREVER_MS);
+
+void ui_start(void)
+{
+	k_thread_start(ui_tid);
+}
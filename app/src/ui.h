@@ -0,0 +1,83 @@
+/*
+ * =============================================================================
+ * UI thread and update queue
+ * =============================================================================
+ * One thread (the "UI thread") owns every LVGL object: it builds screens,
+ * applies widget updates and renders. Other threads never call LVGL; they
+ * post updates instead:
+ *
+ *   - ui_set_value(slot, v): lock-free. The value goes into an atomic slot
+ *     and a bit is set in a dirty bitmap. Posting again before the next
+ *     frame just overwrites the slot, so a producer running at kHz rates
+ *     costs at most one widget update per frame.
+ *   - ui_set_text(slot, s):  copied into a k_msgq (no mutex, never blocks).
+ *     The newest text per slot wins when the queue is drained.
+ *   - ui_show_screen(s):     latest request wins; rendered without waiting
+ *     for the frame rate cap.
+ *
+ * All three are safe from any thread and from interrupt handlers, and wake
+ * the render scheduler. Pending updates are applied right before LVGL runs,
+ * so each frame sees one consistent set of values.
+ *
+ * Slots are connected to widgets from the UI thread (normally in a screen's
+ * build function) with ui_bind_value() / ui_bind_label() / ui_bind_text().
+ * Updates for a slot that is not bound yet are kept until it is.
+ *
+ * Each binding remembers what its widget currently shows. A value or text
+ * that did not change is dropped before LVGL sees it, so it costs no
+ * setter call, no invalidation and no redraw. Posting an unchanged value
+ * does not even wake the UI thread. Labels are set with
+ * lv_label_set_text_static() on fixed buffers owned by this module, so
+ * updating a label never touches the LVGL heap.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * =============================================================================
+ */
+
+#ifndef APP_UI_H_
+#define APP_UI_H_
+
+#include <lvgl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "screen_cache.h"
+
+/* Applies a posted value to its widget (e.g. lv_bar_set_value) */
+typedef void (*ui_value_fn)(lv_obj_t *obj, int32_t value);
+
+/* Formats a posted value as label text (e.g. snprintf "%d:%02d") */
+typedef void (*ui_format_fn)(char *buf, size_t len, int32_t value);
+
+/*
+ * Start the UI thread. Until this is called the caller owns LVGL (boot
+ * code builds screens and renders the first frame); afterwards only the UI
+ * thread may touch LVGL objects.
+ */
+void ui_start(void);
+
+/* Ask the UI thread to show screen 's' (building it on first use) */
+void ui_show_screen(struct screen *s);
+
+/* Post a new value for a value slot. Returns -EINVAL for a bad slot. */
+int ui_set_value(unsigned int slot, int32_t value);
+
+/*
+ * Post a new text for a text slot (truncated to CONFIG_APP_UI_TEXT_LEN - 1
+ * characters). Returns -EINVAL for a bad slot, -ENOMSG if the queue is full.
+ */
+int ui_set_text(unsigned int slot, const char *text);
+
+/* UI thread only: connect a slot to a widget */
+void ui_bind_value(unsigned int slot, lv_obj_t *obj, ui_value_fn fn);
+void ui_bind_text(unsigned int slot, lv_obj_t *label);
+
+/* UI thread only: show a value slot as text. The label points at a static
+ * buffer owned by this module (lv_label_set_text_static). */
+void ui_bind_label(unsigned int slot, lv_obj_t *label, ui_format_fn format);
+
+/* UI thread only: apply every pending update. Called by the render
+ * scheduler before each LVGL run. */
+void ui_apply_pending(void);
+
+#endif /* APP_UI_H_ */
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""Turn the CAPTURE lines of a native_sim benchmark run into PBM images.
+
+The format of the lines is described in app/src/capture_display.h.
+
+Examples:
+    zephyr.exe | capture_frames.py - --out frames/           # write PBMs
+    capture_frames.py run.log --golden ref/ --update         # save reference
+    capture_frames.py run.log --golden ref/                  # compare
+
+Exits with status 1 if a frame differs from its golden image.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+LINE_RE = re.compile(r"CAPTURE,screen=([^,]+),(.*)")
+
+
+def parse(stream):
+    """Return {screen: {"pages": [...], "writes": n, "bytes": n}}."""
+    screens = {}
+    for line in stream:
+        m = LINE_RE.search(line)
+        if not m:
+            continue
+        name, rest = m.groups()
+        scr = screens.setdefault(name, {"pages": {}, "writes": 0, "bytes": 0})
+        fields = rest.strip().split(",")
+        if fields[0].startswith("page="):
+            scr["pages"][int(fields[0][5:])] = bytes.fromhex(fields[1])
+        else:
+            for f in fields:
+                key, val = f.split("=")
+                scr[key] = int(val)
+    return screens
+
+
+def to_pbm(pages):
+    """Plain PBM, 1 = lit pixel (printed black)."""
+    width = len(pages[0])
+    height = len(pages) * 8
+    rows = []
+    for y in range(height):
+        page = pages[y // 8]
+        rows.append(" ".join(str((page[x] >> (y % 8)) & 1)
+                             for x in range(width)))
+    return "P1\n%d %d\n%s\n" % (width, height, "\n".join(rows))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("log", help="console log of the run, or - for stdin")
+    ap.add_argument("--out", metavar="DIR", help="write <screen>.pbm here")
+    ap.add_argument("--golden", metavar="DIR",
+                    help="compare with <screen>.pbm in DIR")
+    ap.add_argument("--update", action="store_true",
+                    help="overwrite the golden images with this run")
+    args = ap.parse_args()
+
+    stream = sys.stdin if args.log == "-" else open(args.log, errors="replace")
+    screens = parse(stream)
+    if not screens:
+        print("no CAPTURE lines found", file=sys.stderr)
+        return 1
+
+    failed = 0
+    for name, scr in screens.items():
+        pages = [scr["pages"][p] for p in sorted(scr["pages"])]
+        pbm = to_pbm(pages)
+        status = ""
+
+        if args.out:
+            os.makedirs(args.out, exist_ok=True)
+            with open(os.path.join(args.out, name + ".pbm"), "w") as f:
+                f.write(pbm)
+
+        if args.golden:
+            path = os.path.join(args.golden, name + ".pbm")
+            if args.update:
+                os.makedirs(args.golden, exist_ok=True)
+                with open(path, "w") as f:
+                    f.write(pbm)
+                status = "updated"
+            elif not os.path.exists(path):
+                status = "NO GOLDEN (run with --update)"
+                failed += 1
+            elif open(path).read() != pbm:
+                status = "DIFFERS"
+                failed += 1
+            else:
+                status = "ok"
+
+        print("%-8s writes=%-5d bytes=%-6d %s" % (name, scr["writes"],
+                                                  scr["bytes"], status))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""Decode the panel mirror stream (CONFIG_APP_MIRROR) and show the display.
+
+The packet format is described in app/src/mirror.h.
+
+Examples:
+    mirror_decode.py /dev/ttyACM0              # live view (needs pyserial)
+    mirror_decode.py capture.bin --pbm out     # write out/frame_00000.pbm, ...
+"""
+
+import argparse
+import sys
+
+SYNC = b"\xa5\x5a"
+FLAG_KEY = 0x01
+HDR_SIZE = 8
+
+
+def rle_decode(data, pos, n):
+    """Decode RLE tokens until n bytes are produced. Returns (bytes, pos)."""
+    out = bytearray()
+    while len(out) < n:
+        c = data[pos]
+        pos += 1
+        if c & 0x80:
+            out += bytes([data[pos]]) * ((c & 0x7F) + 1)
+            pos += 1
+        else:
+            out += data[pos:pos + c + 1]
+            pos += c + 1
+    if len(out) != n:
+        raise ValueError("RLE data overruns its record")
+    return out, pos
+
+
+class Mirror:
+    def __init__(self):
+        self.width = 0
+        self.pages = 0
+        self.image = None
+        self.synced = False
+        self.seq = None
+        self.lost = 0
+
+    def parse(self, buf):
+        """Consume complete packets from buf; yield after each applied one."""
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                del buf[:max(0, len(buf) - 1)]
+                return
+            del buf[:start]
+            if len(buf) < HDR_SIZE:
+                return
+            try:
+                end = self._apply(bytes(buf))
+            except IndexError:
+                return  # Incomplete: wait for more bytes
+            except ValueError:
+                del buf[:1]  # Not a packet after all (e.g. log text)
+                continue
+            del buf[:end]
+            yield
+
+    def _apply(self, pkt):
+        flags = pkt[2]
+        seq = pkt[3] | (pkt[4] << 8)
+        width, pages, count = pkt[5], pkt[6], pkt[7]
+        pos = HDR_SIZE
+        records = []
+        for _ in range(count):
+            page, x1, n = pkt[pos], pkt[pos + 1], pkt[pos + 2]
+            data, pos = rle_decode(pkt, pos + 3, n)
+            if page >= pages or x1 + n > width:
+                raise ValueError("record outside the panel")
+            records.append((page, x1, data))
+        if sum(pkt[2:pos]) & 0xFF != pkt[pos]:
+            raise ValueError("bad checksum")
+
+        if self.seq is not None and seq != (self.seq + 1) & 0xFFFF:
+            self.lost += 1
+            if not flags & FLAG_KEY:
+                self.synced = False
+        self.seq = seq
+
+        if flags & FLAG_KEY or (width, pages) != (self.width, self.pages):
+            self.width, self.pages = width, pages
+            self.image = [bytearray(width) for _ in range(pages)]
+            self.synced = bool(flags & FLAG_KEY)
+
+        for page, x1, data in records:
+            row = self.image[page]
+            for i, d in enumerate(data):
+                row[x1 + i] ^= d
+        return pos + 1
+
+    def pixel(self, x, y):
+        return (self.image[y // 8][x] >> (y % 8)) & 1
+
+    def ascii(self):
+        # Two pixel rows per text line
+        chars = " ▀▄█"
+        lines = []
+        for y in range(0, self.pages * 8, 2):
+            lines.append("".join(
+                chars[self.pixel(x, y) | (self.pixel(x, y + 1) << 1)]
+                for x in range(self.width)))
+        return "\n".join(lines)
+
+    def pbm(self):
+        rows = []
+        for y in range(self.pages * 8):
+            rows.append(" ".join(str(self.pixel(x, y))
+                                 for x in range(self.width)))
+        return "P1\n%d %d\n%s\n" % (self.width, self.pages * 8,
+                                    "\n".join(rows))
+
+
+def open_source(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+        return serial.Serial(path, baud, timeout=0.1)
+    return open(path, "rb")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawTextHelpFormatter)
+    ap.add_argument("source", help="serial port, capture file or - for stdin")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--pbm", metavar="DIR",
+                    help="write every decoded frame as DIR/frame_NNNNN.pbm")
+    args = ap.parse_args()
+
+    src = open_source(args.source, args.baud)
+    mirror = Mirror()
+    buf = bytearray()
+    frames = 0
+
+    while True:
+        chunk = src.read(256)
+        if not chunk:
+            if hasattr(src, "port"):
+                continue  # Serial timeout
+            break
+        buf += chunk
+        for _ in mirror.parse(buf):
+            if not mirror.synced:
+                continue
+            if args.pbm:
+                name = "%s/frame_%05d.pbm" % (args.pbm, frames)
+                with open(name, "w") as f:
+                    f.write(mirror.pbm())
+            else:
+                sys.stdout.write("\x1b[H\x1b[2J" + mirror.ascii() +
+                                 "\nseq %d, lost %d\n" % (mirror.seq,
+                                                          mirror.lost))
+                sys.stdout.flush()
+            frames += 1
+
+    if args.pbm:
+        print("%d frames written, %d gaps" % (frames, mirror.lost))
+
+
+if __name__ == "__main__":
+    main()
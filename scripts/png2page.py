@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""Convert a PNG into a C header in the panel's page format.
+
+The output is what app/src/page_image.h calls a struct page_image: the
+image cut into 8-row pages, one byte per column and page, bit 0 = top row
+of the page. Lit pixels are 1 bits; the last page is padded with 0 bits
+(transparent). That is the SH1106's own GDDRAM layout, so the panel module
+can blit it with byte copies instead of running it through LVGL.
+
+A pixel is lit when it is light (luma >= 128) and opaque (alpha >= 128),
+or the other way round with --invert. Plain zlib is used, no Pillow.
+
+Example:
+    png2page.py app/assets/smiley.png -o smiley.h --name smiley_page
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+PNG_MAGIC = b"\x89PNG\r\n\x1a\n"
+
+# Samples per pixel of each PNG color type
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def read_chunks(data):
+    if data[:8] != PNG_MAGIC:
+        raise ValueError("not a PNG file")
+    pos = 8
+    while pos < len(data):
+        length, ctype = struct.unpack(">I4s", data[pos:pos + 8])
+        yield ctype, data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+
+
+def unfilter(raw, width, height, bpp, row_bytes):
+    """Undo the per-row PNG filters; returns a list of row byte strings."""
+    rows = []
+    prev = bytearray(row_bytes)
+    pos = 0
+    for _ in range(height):
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + row_bytes])
+        pos += 1 + row_bytes
+        for i in range(row_bytes):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+            elif ftype != 0:
+                raise ValueError("bad PNG filter type %d" % ftype)
+        rows.append(line)
+        prev = line
+    return rows
+
+
+def decode_png(data):
+    """Return (width, height, rows of (luma, alpha) tuples)."""
+    idat = b""
+    palette = []
+    trns = b""
+    for ctype, body in read_chunks(data):
+        if ctype == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(
+                ">IIBBBBB", body)
+        elif ctype == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif ctype == b"tRNS":
+            trns = body
+        elif ctype == b"IDAT":
+            idat += body
+    if interlace:
+        raise ValueError("interlaced PNGs are not supported")
+    if depth == 16:
+        raise ValueError("16-bit PNGs are not supported")
+
+    channels = CHANNELS[color]
+    row_bytes = (width * channels * depth + 7) // 8
+    bpp = max(1, channels * depth // 8)
+    rows = unfilter(zlib.decompress(idat), width, height, bpp, row_bytes)
+    maxval = (1 << depth) - 1
+
+    pixels = []
+    for line in rows:
+        if depth < 8:
+            samples = [(line[i * depth // 8] >> (8 - depth - (i * depth) % 8))
+                       & maxval for i in range(width)]
+        else:
+            samples = list(line)
+        out = []
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            if color == 3:
+                r, g, b = palette[s[0]]
+                alpha = trns[s[0]] if s[0] < len(trns) else 255
+            elif color in (0, 4):
+                r = g = b = s[0] * 255 // maxval
+                alpha = s[1] if color == 4 else 255
+            else:
+                r, g, b = s[:3]
+                alpha = s[3] if color == 6 else 255
+            out.append(((r * 299 + g * 587 + b * 114) // 1000, alpha))
+        pixels.append(out)
+    return width, height, pixels
+
+
+def to_pages(width, height, pixels, invert):
+    pages = []
+    for p in range((height + 7) // 8):
+        page = bytearray(width)
+        for bit in range(8):
+            y = p * 8 + bit
+            if y >= height:
+                break
+            for x in range(width):
+                luma, alpha = pixels[y][x]
+                lit = (luma >= 128) != invert and alpha >= 128
+                if lit:
+                    page[x] |= 1 << bit
+        pages.append(page)
+    return pages
+
+
+def write_header(out, name, src, width, height, pages):
+    guard = "APP_IMAGE_%s_H_" % name.upper()
+    out.write("/* Generated by png2page.py from %s. Do not edit. */\n\n" %
+              os.path.basename(src))
+    out.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+    out.write('#include "page_image.h"\n\n')
+    out.write("static const uint8_t %s_data[] = {\n" % name)
+    for p, page in enumerate(pages):
+        out.write("\t/* Page %d */\n" % p)
+        for i in range(0, width, 12):
+            chunk = ", ".join("0x%02X" % b for b in page[i:i + 12])
+            out.write("\t%s,\n" % chunk)
+    out.write("};\n\n")
+    out.write("static const struct page_image %s = {\n" % name)
+    out.write("\t.w = %d,\n\t.h = %d,\n\t.data = %s_data,\n};\n\n" %
+              (width, height, name))
+    out.write("#endif /* %s */\n" % guard)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("png")
+    ap.add_argument("-o", "--output", help="header to write (default: stdout)")
+    ap.add_argument("--name", help="C name (default: from the file name)")
+    ap.add_argument("--invert", action="store_true",
+                    help="light dark pixels instead of light ones")
+    args = ap.parse_args()
+
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(
+        os.path.basename(args.png))[0])
+    with open(args.png, "rb") as f:
+        width, height, pixels = decode_png(f.read())
+    if width > 0xFFFF or height > 0xFF:
+        sys.exit("%s: %dx%d is too big" % (args.png, width, height))
+
+    pages = to_pages(width, height, pixels, args.invert)
+    if args.output:
+        with open(args.output, "w") as out:
+            write_header(out, name, args.png, width, height, pages)
+    else:
+        write_header(sys.stdout, name, args.png, width, height, pages)
+
+
+if __name__ == "__main__":
+    main()